@@ -0,0 +1,54 @@
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "../common/command-line.hpp"
+#include "../common/grid.hpp"
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+#include "../day4/stencil-matcher.hpp"
+#include "../day4/xmas-search.hpp"
+#include "grid-bench.hpp"
+
+/**
+ * @brief Benchmark of the day4 search: the scalar walk against the tiled bitplanes, each on both grids.
+ *
+ * Usage: cares-search-bench <input_data> [runs]
+ * Every variant is run `runs` times (default 100).
+ */
+int main(int argc, char *argv[])
+{
+    size_t runs = 100;
+    if (argc < 2 || argc > 3 || (argc == 3 && (!command_line::parseCount(argv[2], runs) || runs == 0)))
+    {
+        std::cerr << "Usage: " << argv[0] << " <input_data> [runs]" << std::endl;
+        return 1;
+    }
+
+    InputView input(argv[1]);
+
+    if (!input.isOpen())
+    {
+        std::cerr << "ERROR: Could not open the file" << std::endl;
+        return 1;
+    }
+
+    std::string word = "XMAS";
+    StencilMatcher xShape(X_MAS_PATTERN, Symmetry::ALL);
+    auto countScalar = [&](const auto &grid)
+    {
+        return std::make_pair(count_substring(grid, word), count_x_shape_centers(grid));
+    };
+    auto countTiled = [&](const auto &grid)
+    {
+        return count_tiled(grid, word, xShape);
+    };
+
+    results() << "Scalar search:\n";
+    benchmarkGrid<char, BORDER, InputShape>(input, SENTINEL, keepCharacter, countScalar, runs);
+    input.rewind();
+    results() << "Bitplanes:\n";
+    benchmarkGrid<char, BORDER, InputShape>(input, SENTINEL, keepCharacter, countTiled, runs);
+
+    return 0;
+}
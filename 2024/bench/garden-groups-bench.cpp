@@ -0,0 +1,43 @@
+#include <iostream>
+
+#include "../common/command-line.hpp"
+#include "../common/grid.hpp"
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+#include "../day12/garden-regions.hpp"
+#include "grid-bench.hpp"
+
+/**
+ * @brief Benchmark of both day12 prices on the dynamic and on the fixed-size grid.
+ *
+ * Usage: garden-groups-bench <input_data> [runs]
+ * Every variant is run `runs` times (default 100).
+ */
+int main(int argc, char *argv[])
+{
+    size_t runs = 100;
+    if (argc < 2 || argc > 3 || (argc == 3 && (!command_line::parseCount(argv[2], runs) || runs == 0)))
+    {
+        std::cerr << "Usage: " << argv[0] << " <input_data> [runs]" << std::endl;
+        return 1;
+    }
+
+    InputView input(argv[1]);
+
+    if (!input.isOpen())
+    {
+        std::cerr << "ERROR: Could not open the file" << std::endl;
+        return 1;
+    }
+
+    auto price = [](const auto &grid) { return calculatePriceOfFences(grid); };
+    auto discountedPrice = [](const auto &grid) { return calculateDiscountedPriceOfFences(grid); };
+
+    results() << "Perimeter price:\n";
+    benchmarkGrid<char, 1, InputShape>(input, OUTSIDE, keepCharacter, price, runs);
+    input.rewind();
+    results() << "Bulk discount price:\n";
+    benchmarkGrid<char, 1, InputShape>(input, OUTSIDE, keepCharacter, discountedPrice, runs);
+
+    return 0;
+}
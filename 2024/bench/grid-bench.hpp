@@ -0,0 +1,59 @@
+#ifndef AOC_2024_BENCH_GRID_BENCH_HPP
+#define AOC_2024_BENCH_GRID_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "../common/grid.hpp"
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+
+/**
+ * @brief Times a grid solver on the dynamic grid and on the grid dispatchGrid() picks for the input.
+ *
+ * The grid is rebuilt for every run, since solvers may modify it. Both variants must give the
+ * same result; a mismatch is reported. The input is read from its current position, so call
+ * input.rewind() before timing another solver on it.
+ *
+ * @param input The mapped input, positioned at the grid.
+ * @param sentinel Value of the border cells.
+ * @param convert Maps an input character to a cell value.
+ * @param solve The solver, called with the grid.
+ * @param repetitions How many times each variant is run.
+ */
+template <typename T, int Border, typename... Shapes, typename Convert, typename Solve>
+void benchmarkGrid(InputView &input, const T &sentinel, Convert convert, Solve solve, size_t repetitions)
+{
+    std::vector<std::string_view> lines = readGridLines(input);
+    int rows = static_cast<int>(lines.size());
+    int cols = gridColumns(lines);
+    bool fixedShape = ((Shapes::rows == rows && Shapes::cols == cols) || ...);
+
+    auto time = [&](auto run)
+    {
+        auto result = run();
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < repetitions; ++i)
+        {
+            result = run();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::make_pair(result, std::chrono::duration<double, std::milli>(end - start).count() / repetitions);
+    };
+
+    auto [dynamicResult, dynamicTime] = time([&]() { return dispatchGrid<T, Border>(lines, sentinel, convert, solve); });
+    auto [fixedResult, fixedTime] = time([&]() { return dispatchGrid<T, Border, Shapes...>(lines, sentinel, convert, solve); });
+
+    results() << rows << "x" << cols << " grid, " << repetitions << " runs each"
+              << (fixedShape ? "" : " (no fixed-size specialization for this shape)") << '\n';
+    results() << "Dynamic grid: " << dynamicTime << " ms per run\n";
+    results() << "Fixed-size grid: " << fixedTime << " ms per run, speedup " << dynamicTime / fixedTime << "x\n";
+    if (!(dynamicResult == fixedResult))
+    {
+        results() << "ERROR: The two grids gave different results.\n";
+    }
+}
+
+#endif // AOC_2024_BENCH_GRID_BENCH_HPP
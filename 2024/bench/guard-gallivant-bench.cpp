@@ -0,0 +1,46 @@
+#include <iostream>
+
+#include "../common/command-line.hpp"
+#include "../common/grid.hpp"
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+#include "../day6/guard-walk.hpp"
+#include "grid-bench.hpp"
+
+/**
+ * @brief Benchmark of both day6 parts on the dynamic and on the fixed-size grid.
+ *
+ * Usage: guard-gallivant-bench <input_data> [part1_runs] [part2_runs]
+ * Part 1 is a single walk and runs 100 times by default; part 2 replays a walk for every
+ * free cell and runs once by default.
+ */
+int main(int argc, char *argv[])
+{
+    size_t part1Runs = 100;
+    size_t part2Runs = 1;
+    if (argc < 2 || argc > 4 || (argc >= 3 && (!command_line::parseCount(argv[2], part1Runs) || part1Runs == 0)) ||
+        (argc >= 4 && (!command_line::parseCount(argv[3], part2Runs) || part2Runs == 0)))
+    {
+        std::cerr << "Usage: " << argv[0] << " <input_data> [part1_runs] [part2_runs]" << std::endl;
+        return 1;
+    }
+
+    InputView input(argv[1]);
+
+    if (!input.isOpen())
+    {
+        std::cerr << "ERROR: Could not open the file" << std::endl;
+        return 1;
+    }
+
+    auto navigate = [](auto &grid) { return navigateGrid(grid); };
+    auto count = [](auto &grid) { return countObstructionLocations(grid); };
+
+    results() << "Part 1:\n";
+    benchmarkGrid<char, 1, InputShape>(input, OUTSIDE, keepCharacter, navigate, part1Runs);
+    input.rewind();
+    results() << "Part 2:\n";
+    benchmarkGrid<char, 1, InputShape>(input, OUTSIDE, keepCharacter, count, part2Runs);
+
+    return 0;
+}
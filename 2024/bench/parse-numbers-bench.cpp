@@ -0,0 +1,141 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstring>
+
+#include "../common/command-line.hpp"
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+#include "../common/number-parser.hpp"
+
+/**
+ * @brief Writes a synthetic day1-shaped input ("<a>   <b>" per line) to the given file.
+ *
+ * @param filename The file to create.
+ * @param numberOfLines How many lines to generate.
+ */
+void generateInput(const std::string &filename, size_t numberOfLines)
+{
+    std::ofstream file(filename);
+    std::mt19937 rng(2024);
+    std::uniform_int_distribution<int> dist(10000, 99999);
+    std::string buffer;
+
+    for (size_t i = 0; i < numberOfLines; ++i)
+    {
+        buffer += std::to_string(dist(rng));
+        buffer += "   ";
+        buffer += std::to_string(dist(rng));
+        buffer += '\n';
+    }
+    file << buffer;
+}
+
+/**
+ * @brief Parses two columns the way the solvers used to: std::getline + std::istringstream.
+ */
+int64_t parseWithStreams(const std::string &filename)
+{
+    std::ifstream file(filename);
+    std::vector<int64_t> column1, column2;
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        std::istringstream iss(line);
+        int64_t num1, num2;
+        if (iss >> num1 >> num2)
+        {
+            column1.push_back(num1);
+            column2.push_back(num2);
+        }
+    }
+
+    int64_t checksum = 0;
+    for (size_t i = 0; i < column1.size(); ++i)
+    {
+        checksum += column1[i] - 2 * column2[i];
+    }
+    return checksum;
+}
+
+/**
+ * @brief Parses two columns with the mapped input and the SIMD tokenizer.
+ */
+int64_t parseWithKernel(const std::string &filename)
+{
+    InputView input(filename);
+    std::vector<std::vector<int64_t>> columns(2);
+
+    parseIntegerColumns(input.data(), columns);
+
+    int64_t checksum = 0;
+    for (size_t i = 0; i < columns[0].size(); ++i)
+    {
+        checksum += columns[0][i] - 2 * columns[1][i];
+    }
+    return checksum;
+}
+
+/**
+ * @brief Runs `parse` and prints how long it took.
+ */
+template <typename Function>
+int64_t timeRun(const std::string &name, Function &&parse)
+{
+    auto start = std::chrono::steady_clock::now();
+    int64_t checksum = parse();
+    auto end = std::chrono::steady_clock::now();
+
+    results() << name << ": " << std::chrono::duration<double, std::milli>(end - start).count()
+              << " ms (checksum " << checksum << ")\n";
+    return checksum;
+}
+
+/**
+ * @brief Microbenchmark of the integer parsing kernel against the istringstream path.
+ *
+ * Usage: parse-numbers-bench [input_file | --lines number_of_lines]
+ * Without an input file, a synthetic file with `number_of_lines` lines (default 5 000 000)
+ * is generated in the working directory.
+ */
+int main(int argc, char *argv[])
+{
+    std::string filename = "run__bench_input";
+    size_t numberOfLines = 5000000;
+    bool generate = true;
+
+    if (argc == 2 && argv[1][0] != '-')
+    {
+        filename = argv[1];
+        generate = false;
+    }
+    else if (argc != 1 && !(argc == 3 && std::strcmp(argv[1], "--lines") == 0 &&
+                            command_line::parseCount(argv[2], numberOfLines) && numberOfLines > 0))
+    {
+        std::cerr << "Usage: " << argv[0] << " [input_file | --lines number_of_lines]" << std::endl;
+        return 1;
+    }
+
+    if (generate)
+    {
+        LOG_INFO("Generating ", numberOfLines, " lines into ", filename);
+        generateInput(filename, numberOfLines);
+    }
+
+    int64_t streamChecksum = timeRun("istringstream", [&] { return parseWithStreams(filename); });
+    int64_t kernelChecksum = timeRun("mmap + SIMD tokenizer", [&] { return parseWithKernel(filename); });
+
+    if (streamChecksum != kernelChecksum)
+    {
+        std::cerr << "ERROR: Checksums differ" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
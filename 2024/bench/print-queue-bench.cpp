@@ -0,0 +1,127 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <thread>
+
+#include "../common/command-line.hpp"
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+#include "../day5/page-ranking.hpp"
+#include "../day5/page-rules.hpp"
+#include "../day5/update-checks.hpp"
+
+/**
+ * @brief Times the parallel check on synthetic updates built from the updates of the input.
+ *
+ * Each synthetic update is a random input update, shuffled half of the time, so the mix of
+ * valid and invalid updates is about even. The check is timed with 1, 2, 4, ... threads up to
+ * `maxThreads`, and every run must give the same sums as the single threaded one.
+ *
+ * @param numberOfUpdates How many updates to generate.
+ * @param maxThreads The largest number of threads to time; 0 for one per core.
+ */
+void run_benchmark(const PageRules &rules, const PageRanking &ranking, const Updates &input,
+                   const CheckOptions &options, size_t numberOfUpdates, unsigned maxThreads) {
+    if (input.size() == 0) {
+        std::cerr << "ERROR: The input has no updates to build synthetic ones from\n";
+        return;
+    }
+
+    std::mt19937 rng(2024);
+    Updates updates;
+    updates.pages.reserve(input.pages.size() / input.size() * numberOfUpdates * 11 / 10);
+    updates.offsets.reserve(numberOfUpdates + 1);
+    for (size_t u = 0; u < numberOfUpdates; ++u) {
+        size_t from = rng() % input.size();
+        size_t begin = updates.pages.size();
+        updates.pages.insert(updates.pages.end(), input.pages.begin() + input.offsets[from], input.pages.begin() + input.offsets[from + 1]);
+        if (rng() % 2) {
+            std::shuffle(updates.pages.begin() + begin, updates.pages.end(), rng);
+        }
+        updates.offsets.push_back(updates.pages.size());
+    }
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    if (maxThreads == 0) {
+        maxThreads = cores;
+    }
+    results() << numberOfUpdates << " updates, " << cores << " cores\n";
+    UpdateSums reference;
+    double singleThreadTime = 0;
+    for (unsigned threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+        auto start = std::chrono::steady_clock::now();
+        UpdateSums sums = check_updates_parallel(rules, ranking, updates, options, threads);
+        auto end = std::chrono::steady_clock::now();
+        double time = std::chrono::duration<double, std::milli>(end - start).count();
+        if (threads == 1) {
+            reference = sums;
+            singleThreadTime = time;
+        }
+        results() << threads << " threads: " << time << " ms, speedup " << singleThreadTime / time << "x\n";
+        if (sums.middlesOfValidUpdates != reference.middlesOfValidUpdates || sums.middlesOfFixedUpdates != reference.middlesOfFixedUpdates) {
+            results() << "ERROR: The sums differ from the single threaded run.\n";
+        }
+        if (threads == maxThreads) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Benchmark of the parallel day5 update check.
+ *
+ * Usage: print-queue-bench <input_data> [--updates N] [--threads N] [--kahn] [--no-ranking]
+ * Builds N synthetic updates (default 10 000 000) from the updates of the input and times the
+ * check with 1, 2, 4, ... threads up to `--threads` (default one per core). `--kahn` and
+ * `--no-ranking` pick the check the same way as in the solver.
+ */
+int main(int argc, char *argv[]) {
+    CheckOptions options;
+    size_t numberOfUpdates = 10000000;
+    size_t maxThreads = 0;
+    bool validArguments = argc >= 2 && argv[1][0] != '-';
+    for (int i = 2; i < argc && validArguments; ++i) {
+        if (std::strcmp(argv[i], "--kahn") == 0) {
+            options.kahnMode = true;
+        }
+        else if (std::strcmp(argv[i], "--no-ranking") == 0) {
+            options.rankingMode = false;
+        }
+        else if (std::strcmp(argv[i], "--updates") == 0 && i + 1 < argc) {
+            validArguments = command_line::parseCount(argv[++i], numberOfUpdates) && numberOfUpdates > 0;
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            validArguments = command_line::parseCount(argv[++i], maxThreads) && maxThreads > 0;
+        }
+        else {
+            validArguments = false;
+        }
+    }
+    if (!validArguments) {
+        std::cerr << "Usage: " << argv[0] << " <input_data> [--updates N] [--threads N] [--kahn] [--no-ranking]\n";
+        return 1;
+    }
+
+    InputView input(argv[1]);
+
+    if (!input.isOpen()) {
+        std::cerr << "ERROR: Could not open the file\n";
+        return 1;
+    }
+
+    std::vector<std::vector<int64_t>> ruleColumns;
+    Updates updates;
+    parseInput(input.data(), ruleColumns, updates);
+    PageRules rules(ruleColumns[0], ruleColumns[1]);
+    PageRanking ranking(rules);
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    run_benchmark(rules, ranking, updates, options, numberOfUpdates, static_cast<unsigned>(std::min<size_t>(maxThreads, cores)));
+
+    return 0;
+}
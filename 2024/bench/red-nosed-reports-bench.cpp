@@ -0,0 +1,77 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdint>
+
+#include "../common/command-line.hpp"
+#include "../common/log.hpp"
+#include "../day2/report-checks.hpp"
+
+/**
+ * @brief Times the brute force and the single pass Problem Dampener on long generated reports.
+ *
+ * @param numberOfReports How many reports to generate, at least 1.
+ * @param numberOfLevels How many levels each report has, at least 1.
+ */
+void runBenchmark(size_t numberOfReports, size_t numberOfLevels)
+{
+    std::mt19937 rng(2024);
+    Reports reports;
+    std::vector<int> report;
+    for (size_t r = 0; r < numberOfReports; ++r)
+    {
+        // a long ascending report with one or two random glitches
+        report.clear();
+        int level = 1;
+        for (size_t i = 0; i < numberOfLevels; ++i)
+        {
+            level += 1 + rng() % 3;
+            report.push_back(level);
+        }
+        for (int glitches = 1 + rng() % 2; glitches > 0; --glitches)
+        {
+            report[rng() % numberOfLevels] = rng() % (level + 1);
+        }
+        reports.add(report);
+    }
+
+    auto time = [&](const char *name, bool (*check)(Report report))
+    {
+        auto start = std::chrono::steady_clock::now();
+        size_t safe = 0;
+        for (size_t r = 0; r < reports.size(); ++r)
+        {
+            safe += check(reports[r]);
+        }
+        auto end = std::chrono::steady_clock::now();
+        results() << name << ": " << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms, " << safe << " safe reports\n";
+    };
+
+    results() << numberOfReports << " reports with " << numberOfLevels << " levels each\n";
+    time("Brute force (retry per level)", isSafeWithOneRemovalBruteForce);
+    time("Single pass (prefix/suffix)", isSafeWithOneRemoval);
+}
+
+/**
+ * @brief Benchmark of the day2 Problem Dampener: brute force against the single pass check.
+ *
+ * Usage: red-nosed-reports-bench [reports] [levels]
+ * Generates `reports` reports (default 200) of `levels` levels each (default 5000).
+ */
+int main(int argc, char *argv[])
+{
+    size_t numberOfReports = 200;
+    size_t numberOfLevels = 5000;
+    if (argc > 3 || (argc >= 2 && (!command_line::parseCount(argv[1], numberOfReports) || numberOfReports == 0)) ||
+        (argc >= 3 && (!command_line::parseCount(argv[2], numberOfLevels) || numberOfLevels == 0)))
+    {
+        std::cerr << "Usage: " << argv[0] << " [reports] [levels]" << std::endl;
+        return 1;
+    }
+
+    runBenchmark(numberOfReports, numberOfLevels);
+
+    return 0;
+}
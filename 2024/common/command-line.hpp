@@ -0,0 +1,48 @@
+#ifndef AOC_2024_COMMON_COMMAND_LINE_HPP
+#define AOC_2024_COMMON_COMMAND_LINE_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+
+/**
+ * @brief Checked parsing of numeric command line operands.
+ *
+ * std::stoul throws on text that is not a number and quietly wraps "-1" around, so a typo
+ * on the command line either aborts the program or asks for 2^64 of something. These helpers
+ * report such operands instead, and the caller prints its usage line.
+ *
+ * @code
+ * size_t runs;
+ * if (!command_line::parseCount(argv[i], runs) || runs == 0) { printUsage(argv[0]); return 1; }
+ * @endcode
+ */
+namespace command_line
+{
+    /**
+     * @brief Parses an operand that must be a non-negative decimal number and nothing else.
+     *
+     * @param text The operand.
+     * @param value Set to the number on success, left alone otherwise.
+     * @return false if `text` is empty, negative, has trailing characters or does not fit.
+     */
+    inline bool parseCount(const char *text, size_t &value)
+    {
+        if (text == nullptr || *text < '0' || *text > '9')
+        {
+            return false; // also rejects the sign and leading blanks strtoul would accept
+        }
+
+        char *end = nullptr;
+        errno = 0;
+        unsigned long long parsed = std::strtoull(text, &end, 10);
+        if (*end != '\0' || errno == ERANGE || parsed > static_cast<unsigned long long>(static_cast<size_t>(-1)))
+        {
+            return false;
+        }
+        value = static_cast<size_t>(parsed);
+        return true;
+    }
+}
+
+#endif // AOC_2024_COMMON_COMMAND_LINE_HPP
@@ -0,0 +1,196 @@
+#ifndef AOC_2024_COMMON_EXTERNAL_SORT_HPP
+#define AOC_2024_COMMON_EXTERNAL_SORT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <vector>
+
+#include "radix-sort.hpp"
+
+/**
+ * @brief Out-of-core sort of int64_t values.
+ *
+ * Values are handed over in batches that fit into memory. Every batch is sorted
+ * and written to an anonymous temporary file as a sorted run. The runs are then
+ * read back through a k-way merge, which only keeps one small read buffer per run
+ * in memory. Any number of independent merged streams can be opened over the same runs.
+ *
+ * The temporary files are removed automatically when the sorter is destroyed.
+ */
+class ExternalSorter
+{
+public:
+    /**
+     * @brief Number of values read from a run at a time during the merge.
+     */
+    static constexpr size_t READ_BUFFER_SIZE = 1 << 14;
+
+    ExternalSorter() = default;
+
+    ~ExternalSorter()
+    {
+        for (const auto &run : runs_)
+        {
+            std::fclose(run.file);
+        }
+    }
+
+    ExternalSorter(const ExternalSorter &) = delete;
+    ExternalSorter &operator=(const ExternalSorter &) = delete;
+
+    /**
+     * @brief Sorts a batch of values and writes it out as a new run.
+     *
+     * @param values The batch; it is sorted in place and can be reused by the caller afterwards.
+     */
+    void addRun(std::vector<int64_t> &values)
+    {
+        if (values.empty())
+        {
+            return;
+        }
+
+        radix_sort::sort(values, scratch_);
+
+        std::FILE *file = std::tmpfile();
+        if (file == nullptr || std::fwrite(values.data(), sizeof(int64_t), values.size(), file) != values.size())
+        {
+            std::cerr << "ERROR: Could not write sorted run to a temporary file." << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        runs_.push_back({file, values.size()});
+    }
+
+    /**
+     * @brief Returns the total number of values in all runs.
+     */
+    size_t size() const
+    {
+        size_t total = 0;
+        for (const auto &run : runs_)
+        {
+            total += run.count;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Stream of all values in ascending order, produced by a k-way merge of the runs.
+     *
+     * A stream must not outlive the sorter it was opened from.
+     */
+    class MergedStream
+    {
+    public:
+        /**
+         * @brief Reads the next value.
+         *
+         * @param value Set to the next value on success.
+         * @return true if a value was read, false when all runs are exhausted.
+         */
+        bool next(int64_t &value)
+        {
+            if (heap_.empty())
+            {
+                return false;
+            }
+
+            auto [top, reader] = heap_.top();
+            heap_.pop();
+            value = top;
+
+            int64_t following;
+            if (readers_[reader].next(following))
+            {
+                heap_.push({following, reader});
+            }
+            return true;
+        }
+
+    private:
+        friend class ExternalSorter;
+
+        /**
+         * @brief Buffered reader over one run, with its own file offset.
+         */
+        struct RunReader
+        {
+            RunReader(std::FILE *file, size_t count) : file(file), remaining(count) {}
+
+            std::FILE *file;
+            size_t remaining;
+            long offset = 0;
+            std::vector<int64_t> buffer;
+            size_t position = 0;
+
+            bool next(int64_t &value)
+            {
+                if (position == buffer.size())
+                {
+                    if (remaining == 0)
+                    {
+                        return false;
+                    }
+                    size_t toRead = std::min(remaining, READ_BUFFER_SIZE);
+                    buffer.resize(toRead);
+                    // several streams share the file, so always seek to this reader's position
+                    if (std::fseek(file, offset, SEEK_SET) != 0 ||
+                        std::fread(buffer.data(), sizeof(int64_t), toRead, file) != toRead)
+                    {
+                        std::cerr << "ERROR: Could not read sorted run from a temporary file." << std::endl;
+                        std::exit(EXIT_FAILURE);
+                    }
+                    offset += static_cast<long>(toRead * sizeof(int64_t));
+                    remaining -= toRead;
+                    position = 0;
+                }
+                value = buffer[position++];
+                return true;
+            }
+        };
+
+        using HeapItem = std::pair<int64_t, size_t>; // (value, reader index)
+
+        std::vector<RunReader> readers_;
+        std::priority_queue<HeapItem, std::vector<HeapItem>, std::greater<HeapItem>> heap_;
+    };
+
+    /**
+     * @brief Opens a new merged stream over all runs written so far.
+     */
+    MergedStream merged() const
+    {
+        MergedStream stream;
+        stream.readers_.reserve(runs_.size());
+        for (const auto &run : runs_)
+        {
+            stream.readers_.emplace_back(run.file, run.count);
+        }
+        for (size_t i = 0; i < stream.readers_.size(); ++i)
+        {
+            int64_t value;
+            if (stream.readers_[i].next(value))
+            {
+                stream.heap_.push({value, i});
+            }
+        }
+        return stream;
+    }
+
+private:
+    struct Run
+    {
+        std::FILE *file;
+        size_t count;
+    };
+
+    std::vector<Run> runs_;
+    std::vector<int64_t> scratch_;
+};
+
+#endif // AOC_2024_COMMON_EXTERNAL_SORT_HPP
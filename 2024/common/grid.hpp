@@ -0,0 +1,339 @@
+#ifndef AOC_2024_COMMON_GRID_HPP
+#define AOC_2024_COMMON_GRID_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "input-view.hpp"
+
+/**
+ * @brief Marks a grid extent that is only known at run time.
+ */
+constexpr int DYNAMIC_EXTENT = 0;
+
+/**
+ * @brief Row-major 2D grid stored in one contiguous buffer, surrounded by a sentinel border.
+ *
+ * Every row is padded with `border` sentinel cells on both sides and there are `border`
+ * sentinel rows above and below the map. Walking up to `border` steps away from any map
+ * cell therefore stays inside the buffer, and a neighbor lookup is just `index + offset`:
+ * reaching the edge shows up as reading the sentinel value instead of a bounds check.
+ *
+ * Cells are addressed either by (row, col) in map coordinates, where the map itself spans
+ * [0, rows) x [0, cols) and the border [-border, rows + border), or by a flat cell index
+ * as returned by index(). Flat indices combined with offset() are what the inner loops use.
+ *
+ * This primary template is the fixed-size grid: rows R, columns C and border B are template
+ * arguments, so the stride and all offsets are compile-time constants the compiler can fold
+ * into the addressing and unroll loops over. Grid<T> (R = C = DYNAMIC_EXTENT) is the dynamic
+ * grid below, which has the same interface with the sizes passed to the constructor.
+ * dispatchGrid() picks between the two at load time.
+ */
+template <typename T, int R = DYNAMIC_EXTENT, int C = DYNAMIC_EXTENT, int B = 1>
+class Grid
+{
+public:
+    using value_type = T;
+
+    /**
+     * @brief Creates a grid with every cell, map and border alike, set to `sentinel`.
+     */
+    explicit Grid(const T &sentinel) : cells_(cellCount(), sentinel) {}
+
+    static constexpr int rows() { return R; }
+    static constexpr int cols() { return C; }
+    static constexpr int border() { return B; }
+    static constexpr int stride() { return C + 2 * B; }
+    static constexpr size_t cellCount() { return static_cast<size_t>(R + 2 * B) * (C + 2 * B); }
+
+    static constexpr size_t index(int row, int col)
+    {
+        return static_cast<size_t>(row + B) * stride() + static_cast<size_t>(col + B);
+    }
+    static constexpr int row(size_t index) { return static_cast<int>(index / stride()) - B; }
+    static constexpr int col(size_t index) { return static_cast<int>(index % stride()) - B; }
+    static constexpr std::ptrdiff_t offset(int dRow, int dCol) { return static_cast<std::ptrdiff_t>(dRow) * stride() + dCol; }
+
+    static constexpr std::array<std::ptrdiff_t, 4> orthogonalOffsets()
+    {
+        return {offset(-1, 0), offset(0, 1), offset(1, 0), offset(0, -1)};
+    }
+    static constexpr std::array<std::ptrdiff_t, 8> neighborOffsets()
+    {
+        return {offset(-1, 0), offset(-1, 1), offset(0, 1), offset(1, 1),
+                offset(1, 0), offset(1, -1), offset(0, -1), offset(-1, -1)};
+    }
+
+    static constexpr bool contains(int row, int col) { return row >= 0 && row < R && col >= 0 && col < C; }
+
+    T &operator()(int row, int col) { return cells_[index(row, col)]; }
+    const T &operator()(int row, int col) const { return cells_[index(row, col)]; }
+
+    T &operator[](size_t index) { return cells_[index]; }
+    const T &operator[](size_t index) const { return cells_[index]; }
+
+    T *data() { return cells_.data(); }
+    const T *data() const { return cells_.data(); }
+
+private:
+    std::vector<T> cells_;
+};
+
+/**
+ * @brief Grid whose size and border are chosen at run time.
+ *
+ * The B template argument is unused; the border is passed to the constructor instead.
+ */
+template <typename T, int B>
+class Grid<T, DYNAMIC_EXTENT, DYNAMIC_EXTENT, B>
+{
+public:
+    using value_type = T;
+
+    Grid() = default;
+
+    /**
+     * @brief Creates a grid with every cell, map and border alike, set to `sentinel`.
+     */
+    Grid(int rows, int cols, int border, const T &sentinel)
+        : rows_(rows), cols_(cols), border_(border), stride_(cols + 2 * border),
+          cells_(static_cast<size_t>(rows + 2 * border) * static_cast<size_t>(cols + 2 * border), sentinel)
+    {
+    }
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int border() const { return border_; }
+
+    /**
+     * @brief Distance between two vertically adjacent cells in the flat buffer.
+     */
+    int stride() const { return stride_; }
+
+    /**
+     * @brief Number of cells in the buffer, border included.
+     */
+    size_t cellCount() const { return cells_.size(); }
+
+    /**
+     * @brief Flat index of the cell at (row, col).
+     */
+    size_t index(int row, int col) const
+    {
+        return static_cast<size_t>(row + border_) * stride_ + static_cast<size_t>(col + border_);
+    }
+
+    /**
+     * @brief Map row of a flat index.
+     */
+    int row(size_t index) const { return static_cast<int>(index / stride_) - border_; }
+
+    /**
+     * @brief Map column of a flat index.
+     */
+    int col(size_t index) const { return static_cast<int>(index % stride_) - border_; }
+
+    /**
+     * @brief Flat index difference for a move of (dRow, dCol).
+     */
+    std::ptrdiff_t offset(int dRow, int dCol) const { return static_cast<std::ptrdiff_t>(dRow) * stride_ + dCol; }
+
+    /**
+     * @brief Offsets of the four orthogonal neighbors in the order up, right, down, left.
+     */
+    std::array<std::ptrdiff_t, 4> orthogonalOffsets() const
+    {
+        return {offset(-1, 0), offset(0, 1), offset(1, 0), offset(0, -1)};
+    }
+
+    /**
+     * @brief Offsets of all eight neighbors, clockwise starting with up.
+     */
+    std::array<std::ptrdiff_t, 8> neighborOffsets() const
+    {
+        return {offset(-1, 0), offset(-1, 1), offset(0, 1), offset(1, 1),
+                offset(1, 0), offset(1, -1), offset(0, -1), offset(-1, -1)};
+    }
+
+    /**
+     * @brief Checks if (row, col) lies on the map, i.e. not in the border or outside the buffer.
+     */
+    bool contains(int row, int col) const { return row >= 0 && row < rows_ && col >= 0 && col < cols_; }
+
+    T &operator()(int row, int col) { return cells_[index(row, col)]; }
+    const T &operator()(int row, int col) const { return cells_[index(row, col)]; }
+
+    T &operator[](size_t index) { return cells_[index]; }
+    const T &operator[](size_t index) const { return cells_[index]; }
+
+    T *data() { return cells_.data(); }
+    const T *data() const { return cells_.data(); }
+
+private:
+    int rows_ = 0;
+    int cols_ = 0;
+    int border_ = 0;
+    int stride_ = 0;
+    std::vector<T> cells_;
+};
+
+/**
+ * @brief Reads the lines of the grid at the current position of the input, up to the first empty line or the end of the file.
+ */
+inline std::vector<std::string_view> readGridLines(InputView &input)
+{
+    std::vector<std::string_view> lines;
+    std::string_view line;
+    while (input.nextLine(line) && !line.empty())
+    {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+/**
+ * @brief Number of columns of a grid made of the given lines: the length of the longest one.
+ */
+inline int gridColumns(const std::vector<std::string_view> &lines)
+{
+    size_t cols = 0;
+    for (std::string_view line : lines)
+    {
+        cols = std::max(cols, line.size());
+    }
+    return static_cast<int>(cols);
+}
+
+/**
+ * @brief Copies the lines into the map area of the grid; cells missing from shorter lines keep their value.
+ */
+template <typename GridT, typename Convert>
+void fillGrid(GridT &grid, const std::vector<std::string_view> &lines, Convert convert)
+{
+    for (size_t r = 0; r < lines.size(); ++r)
+    {
+        auto *row = &grid[grid.index(static_cast<int>(r), 0)];
+        for (size_t c = 0; c < lines[r].size(); ++c)
+        {
+            row[c] = convert(lines[r][c]);
+        }
+    }
+}
+
+/**
+ * @brief Loads the grid at the current position of the input, up to the first empty line or the end of the file.
+ *
+ * The number of columns is the length of the longest line; cells missing from shorter lines keep the sentinel.
+ *
+ * @param input The mapped input; its line cursor is left after the grid.
+ * @param border Number of sentinel cells around the map.
+ * @param sentinel Value of the border cells.
+ * @param convert Maps an input character to a cell value.
+ * @return The loaded grid.
+ */
+template <typename T, typename Convert>
+Grid<T> loadGrid(InputView &input, int border, const T &sentinel, Convert convert)
+{
+    std::vector<std::string_view> lines = readGridLines(input);
+    Grid<T> grid(static_cast<int>(lines.size()), gridColumns(lines), border, sentinel);
+    fillGrid(grid, lines, convert);
+    return grid;
+}
+
+/**
+ * @brief Cell conversion for grids of characters: keeps the input character as it is.
+ */
+inline char keepCharacter(char c) { return c; }
+
+/**
+ * @brief Loads a grid of characters as they appear in the input.
+ */
+inline Grid<char> loadGrid(InputView &input, int border, char sentinel)
+{
+    return loadGrid(input, border, sentinel, keepCharacter);
+}
+
+/**
+ * @brief A grid size for which dispatchGrid() instantiates a fixed-size grid.
+ */
+template <int R, int C>
+struct GridShape
+{
+    static constexpr int rows = R;
+    static constexpr int cols = C;
+};
+
+namespace grid_dispatch
+{
+    template <typename GridT, typename Result, typename T, typename Convert, typename Solve>
+    Result runFixed(const std::vector<std::string_view> &lines, const T &sentinel, Convert &convert, Solve &solve)
+    {
+        GridT grid(sentinel);
+        fillGrid(grid, lines, convert);
+        return solve(grid);
+    }
+}
+
+/**
+ * @brief Builds the grid from the given lines and hands it to `solve`.
+ *
+ * If the size of the lines matches one of `Shapes`, `solve` gets a fixed-size
+ * Grid<T, rows, cols, Border>; otherwise it gets a dynamic Grid<T> with the same border.
+ * The match is looked up in a table with one entry per shape, so `solve` (usually a
+ * generic lambda) is compiled once per shape plus once for the dynamic fallback and must
+ * return the same type for all of them.
+ *
+ * @code
+ * int visited = dispatchGrid<char, 1, GridShape<130, 130>>(input, '\0', keepCharacter,
+ *                                                          [](auto &grid) { return walk(grid); });
+ * @endcode
+ *
+ * @param lines The lines of the grid, as returned by readGridLines().
+ * @param sentinel Value of the border cells.
+ * @param convert Maps an input character to a cell value.
+ * @param solve Called with the loaded grid; its result is returned.
+ */
+template <typename T, int Border, typename... Shapes, typename Convert, typename Solve>
+auto dispatchGrid(const std::vector<std::string_view> &lines, const T &sentinel, Convert convert, Solve solve)
+{
+    using Result = decltype(solve(std::declval<Grid<T> &>()));
+    using Run = Result (*)(const std::vector<std::string_view> &, const T &, Convert &, Solve &);
+    struct Entry
+    {
+        int rows;
+        int cols;
+        Run run;
+    };
+    static constexpr std::array<Entry, sizeof...(Shapes)> table = {
+        Entry{Shapes::rows, Shapes::cols,
+              &grid_dispatch::runFixed<Grid<T, Shapes::rows, Shapes::cols, Border>, Result, T, Convert, Solve>}...};
+
+    int rows = static_cast<int>(lines.size());
+    int cols = gridColumns(lines);
+    for (const Entry &entry : table)
+    {
+        if (entry.rows == rows && entry.cols == cols)
+        {
+            return entry.run(lines, sentinel, convert, solve);
+        }
+    }
+
+    Grid<T> grid(rows, cols, Border, sentinel);
+    fillGrid(grid, lines, convert);
+    return solve(grid);
+}
+
+/**
+ * @brief Reads the grid at the current position of the input and hands it to `solve`, see above.
+ */
+template <typename T, int Border, typename... Shapes, typename Convert, typename Solve>
+auto dispatchGrid(InputView &input, const T &sentinel, Convert convert, Solve solve)
+{
+    return dispatchGrid<T, Border, Shapes...>(readGridLines(input), sentinel, convert, solve);
+}
+
+#endif // AOC_2024_COMMON_GRID_HPP
@@ -0,0 +1,190 @@
+#ifndef AOC_2024_COMMON_INPUT_VIEW_HPP
+#define AOC_2024_COMMON_INPUT_VIEW_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <charconv>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Read-only, memory mapped view of an input file.
+ *
+ * The whole file is mapped into memory once and handed out as std::string_view
+ * lines and fields that point straight into the mapping, so reading the input
+ * does not allocate per line the way std::getline + std::istringstream does.
+ * Views returned by the class are valid for as long as the InputView lives.
+ *
+ * Usage mirrors std::ifstream:
+ * @code
+ * InputView input(filename);
+ * if (!input.isOpen()) { ... }
+ * std::string_view line;
+ * while (input.nextLine(line)) { ... }
+ * @endcode
+ */
+class InputView
+{
+public:
+    /**
+     * @brief Maps the given file into memory.
+     *
+     * On failure the view is left closed and isOpen() returns false.
+     *
+     * @param filename Path to the file to map.
+     */
+    explicit InputView(const std::string &filename)
+    {
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return;
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) == 0)
+        {
+            size_ = static_cast<size_t>(st.st_size);
+            if (size_ == 0)
+            {
+                open_ = true; // an empty file is valid, there is just nothing to map
+            }
+            else
+            {
+                void *mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapping != MAP_FAILED)
+                {
+                    ::madvise(mapping, size_, MADV_SEQUENTIAL);
+                    data_ = static_cast<const char *>(mapping);
+                    open_ = true;
+                }
+                else
+                {
+                    size_ = 0;
+                }
+            }
+        }
+        ::close(fd); // the mapping stays valid after the descriptor is closed
+    }
+
+    ~InputView()
+    {
+        if (data_ != nullptr)
+        {
+            ::munmap(const_cast<char *>(data_), size_);
+        }
+    }
+
+    InputView(const InputView &) = delete;
+    InputView &operator=(const InputView &) = delete;
+
+    /**
+     * @brief Checks if the file was successfully mapped.
+     */
+    bool isOpen() const { return open_; }
+
+    /**
+     * @brief Returns the whole file content.
+     */
+    std::string_view data() const { return std::string_view(data_, size_); }
+
+    /**
+     * @brief Returns the size of the file in bytes.
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * @brief Reads the next line, without the trailing newline.
+     *
+     * Behaves like std::getline: the last line is returned even if the file does
+     * not end with a newline, and a trailing newline does not produce an extra empty line.
+     *
+     * @param line Set to the next line on success.
+     * @return true if a line was read, false at the end of the file.
+     */
+    bool nextLine(std::string_view &line)
+    {
+        if (cursor_ >= size_)
+        {
+            return false;
+        }
+
+        std::string_view rest(data_ + cursor_, size_ - cursor_);
+        size_t newlinePos = rest.find('\n');
+        if (newlinePos == std::string_view::npos)
+        {
+            line = rest;
+            cursor_ = size_;
+        }
+        else
+        {
+            line = rest.substr(0, newlinePos);
+            cursor_ += newlinePos + 1;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Moves the line cursor back to the beginning of the file.
+     */
+    void rewind() { cursor_ = 0; }
+
+private:
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+    size_t cursor_ = 0;
+    bool open_ = false;
+};
+
+/**
+ * @brief Pops the next field off the front of a line.
+ *
+ * Leading delimiters are skipped, so runs of separators (e.g. several spaces) count as one.
+ *
+ * @param rest The remaining part of the line, advanced past the returned field.
+ * @param field Set to the next field on success.
+ * @param delimiter The character separating fields.
+ * @return true if a field was found, false if only delimiters were left.
+ */
+inline bool nextField(std::string_view &rest, std::string_view &field, char delimiter = ' ')
+{
+    size_t start = rest.find_first_not_of(delimiter);
+    if (start == std::string_view::npos)
+    {
+        rest = std::string_view();
+        return false;
+    }
+
+    size_t end = rest.find(delimiter, start);
+    if (end == std::string_view::npos)
+    {
+        field = rest.substr(start);
+        rest = std::string_view();
+    }
+    else
+    {
+        field = rest.substr(start, end - start);
+        rest = rest.substr(end + 1);
+    }
+    return true;
+}
+
+/**
+ * @brief Converts a field to an integer without going through a stream.
+ *
+ * @param field The characters to convert.
+ * @param value Set to the parsed value on success.
+ * @return true if the field starts with a number, false otherwise.
+ */
+template <typename T>
+bool parseNumber(std::string_view field, T &value)
+{
+    auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+    return ec == std::errc();
+}
+
+#endif // AOC_2024_COMMON_INPUT_VIEW_HPP
@@ -0,0 +1,158 @@
+#ifndef AOC_2024_COMMON_LOG_HPP
+#define AOC_2024_COMMON_LOG_HPP
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @brief Diagnostic logging with levels that compile away, plus a buffered result writer.
+ *
+ * Levels:
+ *  - LOG_LEVEL_NONE  (0): only results are printed.
+ *  - LOG_LEVEL_INFO  (1): one-off progress messages (LOG_INFO).
+ *  - LOG_LEVEL_DEBUG (2): per-item output from inside loops (LOG_DEBUG).
+ *
+ * The level is picked at compile time with -DLOG_LEVEL=<n>. Without it, builds with
+ * -DNDEBUG (release/timing runs) log nothing and other builds log at INFO. Disabled
+ * LOG_* calls sit behind `if (false)`, so their arguments are never evaluated and the
+ * compiler drops them, while variables used only for logging still count as used.
+ *
+ * Results and log lines go through the same buffered writer, so they keep their order
+ * and the terminal is not flushed after every line the way std::endl does.
+ */
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_DEBUG 2
+
+#ifndef LOG_LEVEL
+#ifdef NDEBUG
+#define LOG_LEVEL LOG_LEVEL_NONE
+#else
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+#endif
+
+/**
+ * @brief Buffered writer for stdout, flushed when the buffer fills up and at program exit.
+ */
+class ResultWriter
+{
+public:
+    static constexpr size_t BUFFER_SIZE = 1 << 16;
+
+    ~ResultWriter() { flush(); }
+
+    template <typename T>
+    ResultWriter &operator<<(const T &value)
+    {
+        if constexpr (std::is_convertible_v<const T &, std::string_view>)
+        {
+            buffer_ += std::string_view(value);
+        }
+        else if constexpr (std::is_same_v<T, char>)
+        {
+            buffer_ += value;
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            buffer_ += std::to_string(value);
+        }
+        else
+        {
+            std::ostringstream oss;
+            oss << value;
+            buffer_ += oss.str();
+        }
+
+        if (buffer_.size() >= BUFFER_SIZE)
+        {
+            flush();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Writes the buffered output to stdout.
+     */
+    void flush()
+    {
+        std::fwrite(buffer_.data(), 1, buffer_.size(), stdout);
+        std::fflush(stdout);
+        buffer_.clear();
+    }
+
+private:
+    std::string buffer_;
+};
+
+/**
+ * @brief The program wide result writer.
+ */
+inline ResultWriter &results()
+{
+    static ResultWriter writer;
+    return writer;
+}
+
+namespace logging
+{
+    /**
+     * @brief Writes all arguments one after another, followed by a newline.
+     */
+    template <typename... Args>
+    void print(const Args &...args)
+    {
+        (results() << ... << args) << '\n';
+    }
+
+    /**
+     * @brief Formats the elements of a range separated by `separator`, for dumping containers in one log line.
+     *
+     * @code
+     * LOG_DEBUG("Stones: ", logging::joined(stones));
+     * @endcode
+     */
+    template <typename Range>
+    std::string joined(const Range &range, std::string_view separator = " ")
+    {
+        std::ostringstream oss;
+        bool first = true;
+        for (const auto &element : range)
+        {
+            if (!first)
+            {
+                oss << separator;
+            }
+            oss << element;
+            first = false;
+        }
+        return oss.str();
+    }
+}
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) logging::print(__VA_ARGS__)
+#else
+#define LOG_INFO(...)                    \
+    do                                   \
+    {                                    \
+        if (false)                       \
+            logging::print(__VA_ARGS__); \
+    } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) logging::print(__VA_ARGS__)
+#else
+#define LOG_DEBUG(...)                   \
+    do                                   \
+    {                                    \
+        if (false)                       \
+            logging::print(__VA_ARGS__); \
+    } while (0)
+#endif
+
+#endif // AOC_2024_COMMON_LOG_HPP
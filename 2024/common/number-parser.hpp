@@ -0,0 +1,236 @@
+#ifndef AOC_2024_COMMON_NUMBER_PARSER_HPP
+#define AOC_2024_COMMON_NUMBER_PARSER_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include <charconv>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Integer tokenizer working directly on a mapped input buffer.
+ *
+ * The input is processed in blocks of 64 bytes. For every block a bit mask of
+ * digit bytes and a bit mask of newlines is built with SIMD compares (AVX2 when
+ * the compiler targets it, SSE2 otherwise, plain loop on other architectures).
+ * The starts of digit runs are then found with a few bit operations on the mask,
+ * so bytes that cannot be part of a number are never looked at one by one.
+ * Each digit run is converted with a short multiply-add loop; runs that are too
+ * long to fit are handed to std::from_chars.
+ *
+ * A '-' directly in front of a digit run makes the number negative.
+ */
+namespace number_parser
+{
+    constexpr size_t BLOCK_SIZE = 64;
+
+    /**
+     * @brief Builds the digit and newline masks for one 64-byte block.
+     *
+     * @param block Pointer to 64 readable bytes.
+     * @param digits Bit i is set if block[i] is in '0'..'9'.
+     * @param newlines Bit i is set if block[i] is '\n'.
+     */
+    inline void classifyBlock(const char *block, uint64_t &digits, uint64_t &newlines)
+    {
+#if defined(__AVX2__)
+        const __m256i zero = _mm256_set1_epi8('0');
+        const __m256i nine = _mm256_set1_epi8(9);
+        const __m256i newline = _mm256_set1_epi8('\n');
+        digits = 0;
+        newlines = 0;
+        for (int i = 0; i < 2; ++i)
+        {
+            __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32 * i));
+            __m256i shifted = _mm256_sub_epi8(bytes, zero);
+            __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, nine), shifted); // unsigned (c - '0') <= 9
+            digits |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(isDigit))) << (32 * i);
+            newlines |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, newline)))) << (32 * i);
+        }
+#elif defined(__SSE2__)
+        const __m128i zero = _mm_set1_epi8('0');
+        const __m128i nine = _mm_set1_epi8(9);
+        const __m128i newline = _mm_set1_epi8('\n');
+        digits = 0;
+        newlines = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+            __m128i shifted = _mm_sub_epi8(bytes, zero);
+            __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(shifted, nine), shifted); // unsigned (c - '0') <= 9
+            digits |= static_cast<uint64_t>(_mm_movemask_epi8(isDigit)) << (16 * i);
+            newlines |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline))) << (16 * i);
+        }
+#else
+        digits = 0;
+        newlines = 0;
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            digits |= static_cast<uint64_t>(static_cast<unsigned char>(block[i] - '0') <= 9) << i;
+            newlines |= static_cast<uint64_t>(block[i] == '\n') << i;
+        }
+#endif
+    }
+
+    /**
+     * @brief Converts the digit run starting at `start`.
+     *
+     * @param data The whole input.
+     * @param start Index of the first digit of the run.
+     * @return The parsed value, negated if the run is preceded by '-'. A run too long for int64_t
+     *         is reported and ends the program rather than being truncated.
+     */
+    inline int64_t parseRun(std::string_view data, size_t start)
+    {
+        const char *first = data.data() + start;
+        const char *last = data.data() + data.size();
+        const char *p = first;
+        int64_t value = 0;
+
+        // 18 digits always fit into int64_t, longer runs go through from_chars
+        while (p < last && p - first < 18 && static_cast<unsigned char>(*p - '0') <= 9)
+        {
+            value = value * 10 + (*p - '0');
+            ++p;
+        }
+        if (p < last && static_cast<unsigned char>(*p - '0') <= 9)
+        {
+            if (std::from_chars(first, last, value).ec == std::errc::result_out_of_range)
+            {
+                std::cerr << "ERROR: Number at offset " << start << " does not fit into 64 bits." << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+        }
+
+        return (start > 0 && data[start - 1] == '-') ? -value : value;
+    }
+
+    /**
+     * @brief Calls `onNumber(value)` for every integer and `onNewline()` for every '\n', in input order.
+     */
+    template <typename NumberCallback, typename NewlineCallback>
+    void scan(std::string_view data, NumberCallback &&onNumber, NewlineCallback &&onNewline)
+    {
+        uint64_t carry = 0; // 1 if the previous block ended inside a digit run
+
+        for (size_t base = 0; base < data.size(); base += BLOCK_SIZE)
+        {
+            uint64_t digits, newlines;
+            if (data.size() - base >= BLOCK_SIZE)
+            {
+                classifyBlock(data.data() + base, digits, newlines);
+            }
+            else
+            {
+                char tail[BLOCK_SIZE];
+                std::memset(tail, ' ', BLOCK_SIZE);
+                std::memcpy(tail, data.data() + base, data.size() - base);
+                classifyBlock(tail, digits, newlines);
+            }
+
+            uint64_t starts = digits & ~((digits << 1) | carry);
+            carry = digits >> 63;
+
+            uint64_t events = starts | newlines;
+            while (events != 0)
+            {
+                int bit = __builtin_ctzll(events);
+                events &= events - 1;
+                if ((newlines >> bit) & 1)
+                {
+                    onNewline();
+                }
+                else
+                {
+                    onNumber(parseRun(data, base + bit));
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Parses every integer of the input into one flat array.
+ *
+ * @param data The input to parse.
+ * @param values Receives all numbers in input order.
+ * @param lineOffsets If not null, receives the offset in `values` where each line starts,
+ *                    followed by one final offset equal to values.size(). Empty lines are kept as empty rows.
+ */
+inline void parseIntegers(std::string_view data, std::vector<int64_t> &values, std::vector<size_t> *lineOffsets = nullptr)
+{
+    if (lineOffsets != nullptr)
+    {
+        lineOffsets->push_back(values.size());
+    }
+
+    number_parser::scan(
+        data,
+        [&](int64_t value) { values.push_back(value); },
+        [&]()
+        {
+            if (lineOffsets != nullptr)
+            {
+                lineOffsets->push_back(values.size());
+            }
+        });
+
+    // a file ending with '\n' has no extra line after it
+    if (lineOffsets != nullptr && !data.empty() && data.back() == '\n')
+    {
+        lineOffsets->pop_back();
+    }
+    if (lineOffsets != nullptr)
+    {
+        lineOffsets->push_back(values.size());
+    }
+}
+
+/**
+ * @brief Parses a table of integers into columns.
+ *
+ * The n-th number of every line goes to columns[n]. Extra numbers on a line are ignored
+ * and lines with fewer numbers than columns are skipped, so all columns end up the same length.
+ *
+ * @param data The input to parse.
+ * @param columns The columns to fill; its size decides how many numbers are read per line.
+ */
+inline void parseIntegerColumns(std::string_view data, std::vector<std::vector<int64_t>> &columns)
+{
+    size_t column = 0;
+
+    auto finishLine = [&]()
+    {
+        if (column != 0 && column < columns.size())
+        {
+            for (size_t c = 0; c < column; ++c)
+            {
+                columns[c].pop_back(); // incomplete row
+            }
+        }
+        column = 0;
+    };
+
+    number_parser::scan(
+        data,
+        [&](int64_t value)
+        {
+            if (column < columns.size())
+            {
+                columns[column].push_back(value);
+            }
+            ++column;
+        },
+        finishLine);
+
+    finishLine();
+}
+
+#endif // AOC_2024_COMMON_NUMBER_PARSER_HPP
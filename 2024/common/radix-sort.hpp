@@ -0,0 +1,130 @@
+#ifndef AOC_2024_COMMON_RADIX_SORT_HPP
+#define AOC_2024_COMMON_RADIX_SORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief LSD radix sort for non-negative integers.
+ *
+ * Keys are sorted 11 bits at a time. The histograms of all digits are built in one
+ * pass over the data, then every digit does one scatter pass between the input and
+ * a scratch buffer (ping-pong), so the data is read 1 + passes times in total.
+ * Only as many digits as needed for the largest key are sorted, e.g. 2 passes for
+ * keys below 2^22.
+ *
+ * Inputs containing negative values fall back to std::sort.
+ */
+namespace radix_sort
+{
+    constexpr int DIGIT_BITS = 11;
+    constexpr size_t BUCKETS = size_t(1) << DIGIT_BITS;
+    constexpr uint64_t DIGIT_MASK = BUCKETS - 1;
+    constexpr int MAX_PASSES = (64 + DIGIT_BITS - 1) / DIGIT_BITS;
+
+    /**
+     * @brief Sorts `values` in place, using `scratch` as the second ping-pong buffer.
+     */
+    inline void sort(std::vector<int64_t> &values, std::vector<int64_t> &scratch)
+    {
+        if (values.size() < 2)
+        {
+            return;
+        }
+
+        int64_t maxValue = *std::max_element(values.begin(), values.end());
+        int64_t minValue = *std::min_element(values.begin(), values.end());
+        if (minValue < 0)
+        {
+            std::sort(values.begin(), values.end());
+            return;
+        }
+
+        int passes = 0;
+        while (passes < MAX_PASSES && (static_cast<uint64_t>(maxValue) >> (passes * DIGIT_BITS)) != 0)
+        {
+            passes++;
+        }
+
+        // histograms of every digit, in a single pass over the data
+        std::vector<std::array<size_t, BUCKETS>> histograms(passes);
+        for (auto &histogram : histograms)
+        {
+            histogram.fill(0);
+        }
+        for (int64_t value : values)
+        {
+            uint64_t key = static_cast<uint64_t>(value);
+            for (int pass = 0; pass < passes; ++pass)
+            {
+                histograms[pass][(key >> (pass * DIGIT_BITS)) & DIGIT_MASK]++;
+            }
+        }
+
+        scratch.resize(values.size());
+        std::vector<int64_t> *source = &values;
+        std::vector<int64_t> *destination = &scratch;
+
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            auto &histogram = histograms[pass];
+
+            // a digit where all keys fall into one bucket does not change the order
+            if (std::find(histogram.begin(), histogram.end(), values.size()) != histogram.end())
+            {
+                continue;
+            }
+
+            size_t offset = 0;
+            for (size_t &count : histogram)
+            {
+                size_t bucketSize = count;
+                count = offset;
+                offset += bucketSize;
+            }
+
+            int shift = pass * DIGIT_BITS;
+            for (int64_t value : *source)
+            {
+                (*destination)[histogram[(static_cast<uint64_t>(value) >> shift) & DIGIT_MASK]++] = value;
+            }
+            std::swap(source, destination);
+        }
+
+        if (source != &values)
+        {
+            values.swap(scratch);
+        }
+    }
+
+    /**
+     * @brief Sorts `values` in place.
+     */
+    inline void sort(std::vector<int64_t> &values)
+    {
+        std::vector<int64_t> scratch;
+        sort(values, scratch);
+    }
+
+    /**
+     * @brief Sorts two independent columns, each on its own thread if `parallel` is set.
+     */
+    inline void sortColumns(std::vector<int64_t> &column1, std::vector<int64_t> &column2, bool parallel = true)
+    {
+        if (!parallel)
+        {
+            sort(column1);
+            sort(column2);
+            return;
+        }
+
+        std::thread worker([&column2]() { sort(column2); });
+        sort(column1);
+        worker.join();
+    }
+}
+
+#endif // AOC_2024_COMMON_RADIX_SORT_HPP
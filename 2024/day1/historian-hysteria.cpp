@@ -1,72 +1,414 @@
 #include <iostream>
-#include <fstream>
 #include <vector>
-#include <sstream>
-#include <algorithm>
 #include <cmath>
-#include <numeric>
-#include <unordered_map>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
-int main(int argc, char *argv[]) {
-    if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <input_data>" << std::endl;
-        return 1;
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+#include "../common/number-parser.hpp"
+#include "../common/radix-sort.hpp"
+#include "../common/external-sort.hpp"
+
+/**
+ * @brief Sums the distances between the n-th smallest elements of both columns.
+ *
+ * @param column1 The left list, sorted.
+ * @param column2 The right list, sorted.
+ * @return The total distance.
+ */
+int64_t calculateSumOfDistances(const std::vector<int64_t> &column1, const std::vector<int64_t> &column2)
+{
+    int64_t sumOfDistances = 0;
+    for (size_t i = 0; i < column1.size(); ++i)
+    {
+        sumOfDistances += std::abs(column1[i] - column2[i]);
     }
+    return sumOfDistances;
+}
 
-    std::string filename = argv[1];
+/**
+ * @brief Calculates the similarity score with a merge-join of both sorted columns.
+ *
+ * Every number of the left list is multiplied by how often it appears in the right list.
+ * Both columns are walked once, run by run: for each value the length of its run in
+ * both columns is counted and the run pair contributes value * leftCount * rightCount.
+ *
+ * @param column1 The left list, sorted.
+ * @param column2 The right list, sorted.
+ * @return The total similarity score.
+ */
+int64_t calculateSimilarityScore(const std::vector<int64_t> &column1, const std::vector<int64_t> &column2)
+{
+    int64_t sumOfSimilarityScores = 0;
+    size_t i = 0, j = 0;
+
+    while (i < column1.size() && j < column2.size())
+    {
+        if (column1[i] < column2[j])
+        {
+            i++;
+        }
+        else if (column1[i] > column2[j])
+        {
+            j++;
+        }
+        else
+        {
+            int64_t value = column1[i];
+            int64_t leftCount = 0, rightCount = 0;
+            for (; i < column1.size() && column1[i] == value; ++i)
+                leftCount++;
+            for (; j < column2.size() && column2[j] == value; ++j)
+                rightCount++;
+            sumOfSimilarityScores += value * leftCount * rightCount;
+        }
+    }
+    return sumOfSimilarityScores;
+}
+
+/**
+ * @brief Size of the input slice parsed into one sorted run in external mode.
+ *
+ * 64 MB of input is roughly 4.5M rows, i.e. about 72 MB of int64_t columns in memory.
+ */
+constexpr size_t EXTERNAL_RUN_BYTES = size_t(64) << 20;
 
-    std::ifstream file(filename);
-    std::vector<int> column1, column2, distance;
-    std::string line;
-    int sumOfDistances, sumOfSimilarityScores;
+/**
+ * @brief Computes both totals with bounded memory by sorting the columns out of core.
+ *
+ * The input is parsed slice by slice (cut at line boundaries); every slice becomes one
+ * sorted run per column on disk. The sum of distances is then computed by walking the
+ * merged streams of both columns in lockstep, and the similarity score by a merge-join
+ * over a second pair of merged streams.
+ *
+ * @param input The mapped input.
+ * @param sumOfDistances Set to the total distance.
+ * @param sumOfSimilarityScores Set to the total similarity score.
+ */
+void calculateTotalsExternal(const InputView &input, int64_t &sumOfDistances, int64_t &sumOfSimilarityScores)
+{
+    std::string_view data = input.data();
+    ExternalSorter sorter1, sorter2;
+    std::vector<std::vector<int64_t>> columns(2);
 
-    if (!file.is_open())
+    while (!data.empty())
     {
-        std::cerr << "ERROR: Could not open the file";
-        return 1;
+        size_t sliceEnd = data.size();
+        if (sliceEnd > EXTERNAL_RUN_BYTES)
+        {
+            size_t newlinePos = data.rfind('\n', EXTERNAL_RUN_BYTES);
+            sliceEnd = newlinePos == std::string_view::npos ? data.size() : newlinePos + 1;
+        }
+
+        columns[0].clear();
+        columns[1].clear();
+        parseIntegerColumns(data.substr(0, sliceEnd), columns);
+        sorter1.addRun(columns[0]);
+        sorter2.addRun(columns[1]);
+        data.remove_prefix(sliceEnd);
     }
 
-    while (std::getline(file, line))
+    columns = {}; // release the slice buffers before merging
+
+    sumOfDistances = 0;
+    auto left = sorter1.merged();
+    auto right = sorter2.merged();
+    int64_t num1, num2;
+    while (left.next(num1) && right.next(num2))
     {
-        std::istringstream iss(line);
-        int num1, num2;
-        if (iss >> num1 >> num2)
+        sumOfDistances += std::abs(num1 - num2);
+    }
+
+    sumOfSimilarityScores = 0;
+    left = sorter1.merged();
+    right = sorter2.merged();
+    bool hasLeft = left.next(num1);
+    bool hasRight = right.next(num2);
+    while (hasLeft && hasRight)
+    {
+        if (num1 < num2)
+        {
+            hasLeft = left.next(num1);
+        }
+        else if (num1 > num2)
         {
-            column1.push_back(num1);
-            column2.push_back(num2);
+            hasRight = right.next(num2);
+        }
+        else
+        {
+            int64_t value = num1;
+            int64_t leftCount = 0, rightCount = 0;
+            while (hasLeft && num1 == value)
+            {
+                leftCount++;
+                hasLeft = left.next(num1);
+            }
+            while (hasRight && num2 == value)
+            {
+                rightCount++;
+                hasRight = right.next(num2);
+            }
+            sumOfSimilarityScores += value * leftCount * rightCount;
         }
     }
+}
 
-    file.close();
+/**
+ * @brief Fenwick (binary indexed) tree of counts over the value domain [0, size).
+ */
+class FenwickTree
+{
+public:
+    explicit FenwickTree(size_t size) : tree_(size + 1, 0) {}
 
-    std::sort(column1.begin(), column1.end());
-    std::sort(column2.begin(), column2.end());
+    /**
+     * @brief Adds `delta` to the count of `value`.
+     */
+    void add(size_t value, int64_t delta)
+    {
+        for (size_t i = value + 1; i < tree_.size(); i += i & (~i + 1))
+        {
+            tree_[i] += delta;
+        }
+    }
 
-    for (size_t i = 0; i < column1.size(); ++i)
+    /**
+     * @brief Returns the number of values <= `value`.
+     */
+    int64_t prefixCount(size_t value) const
+    {
+        int64_t count = 0;
+        for (size_t i = value + 1; i > 0; i -= i & (~i + 1))
+        {
+            count += tree_[i];
+        }
+        return count;
+    }
+
+    /**
+     * @brief Returns how many times `value` was added.
+     */
+    int64_t count(size_t value) const
+    {
+        return prefixCount(value) - (value == 0 ? 0 : prefixCount(value - 1));
+    }
+
+private:
+    std::vector<int64_t> tree_;
+};
+
+/**
+ * @brief Keeps the day1 totals up to date while (left, right) pairs are appended.
+ *
+ * Both lists live in value-domain Fenwick trees, so the similarity score only needs
+ * one count lookup per appended number.
+ *
+ * The distance uses the identity sum |L_i - R_i| = sum over t of |D(t)|, where
+ * D(t) = #(L <= t) - #(R <= t) and L, R are the sorted lists. Appending (a, b) adds +1
+ * to D on [a, b) (or -1 on [b, a)), so the distance changes by sum(|D + 1| - |D|) over
+ * that range. D is kept in a segment tree with lazy range add and min/max per node:
+ * a node whose values all stay on one side of zero contributes delta * length at once,
+ * so an update costs O(log V) per run of equal sign of D inside the updated range.
+ */
+class IncrementalTotals
+{
+public:
+    /**
+     * @param maxValue The largest ID that can appear in either list.
+     */
+    explicit IncrementalTotals(int64_t maxValue)
+        : domain_(static_cast<size_t>(maxValue) + 1), left_(domain_), right_(domain_),
+          min_(4 * domain_, 0), max_(4 * domain_, 0), lazy_(4 * domain_, 0)
+    {
+    }
+
+    /**
+     * @brief Appends one pair and updates both totals.
+     *
+     * @return false if a value is outside [0, maxValue] and the pair was ignored.
+     */
+    bool addPair(int64_t leftValue, int64_t rightValue)
+    {
+        if (leftValue < 0 || rightValue < 0 || leftValue >= static_cast<int64_t>(domain_) || rightValue >= static_cast<int64_t>(domain_))
+        {
+            return false;
+        }
+
+        size_t a = static_cast<size_t>(leftValue);
+        size_t b = static_cast<size_t>(rightValue);
+
+        sumOfSimilarityScores_ += leftValue * right_.count(a);
+        left_.add(a, 1);
+        sumOfSimilarityScores_ += rightValue * left_.count(b);
+        right_.add(b, 1);
+
+        if (a < b)
+        {
+            sumOfDistances_ += update(1, 0, domain_ - 1, a, b - 1, 1);
+        }
+        else if (b < a)
+        {
+            sumOfDistances_ += update(1, 0, domain_ - 1, b, a - 1, -1);
+        }
+        return true;
+    }
+
+    int64_t sumOfDistances() const { return sumOfDistances_; }
+    int64_t sumOfSimilarityScores() const { return sumOfSimilarityScores_; }
+
+private:
+    /**
+     * @brief Adds `delta` to D on [from, to] and returns the change of sum |D| over that range.
+     */
+    int64_t update(size_t node, size_t nodeFrom, size_t nodeTo, size_t from, size_t to, int delta)
+    {
+        if (to < nodeFrom || nodeTo < from)
+        {
+            return 0;
+        }
+
+        int64_t length = static_cast<int64_t>(nodeTo - nodeFrom + 1);
+        if (from <= nodeFrom && nodeTo <= to)
+        {
+            // all values stay >= 0 or all stay <= 0, so every |D| moves by the same amount
+            if (min_[node] >= 0 && min_[node] + delta >= 0)
+            {
+                apply(node, delta);
+                return delta * length;
+            }
+            if (max_[node] <= 0 && max_[node] + delta <= 0)
+            {
+                apply(node, delta);
+                return -delta * length;
+            }
+        }
+
+        pushDown(node);
+        size_t middle = nodeFrom + (nodeTo - nodeFrom) / 2;
+        int64_t change = update(2 * node, nodeFrom, middle, from, to, delta) +
+                         update(2 * node + 1, middle + 1, nodeTo, from, to, delta);
+        min_[node] = std::min(min_[2 * node], min_[2 * node + 1]);
+        max_[node] = std::max(max_[2 * node], max_[2 * node + 1]);
+        return change;
+    }
+
+    void apply(size_t node, int64_t delta)
+    {
+        min_[node] += delta;
+        max_[node] += delta;
+        lazy_[node] += delta;
+    }
+
+    void pushDown(size_t node)
     {
-        distance.push_back(std::abs(column1[i] - column2[i]));
+        if (lazy_[node] != 0)
+        {
+            apply(2 * node, lazy_[node]);
+            apply(2 * node + 1, lazy_[node]);
+            lazy_[node] = 0;
+        }
     }
 
-    sumOfDistances = std::accumulate(distance.begin(), distance.end(), 0);
+    size_t domain_;
+    FenwickTree left_, right_;
+    std::vector<int64_t> min_, max_, lazy_;
+    int64_t sumOfDistances_ = 0;
+    int64_t sumOfSimilarityScores_ = 0;
+};
 
-    std::unordered_map<int, int> count_map;
+/**
+ * @brief Largest `--incremental` bound accepted.
+ *
+ * The trees take about 12 int64_t per value of the domain, so this is roughly 1 GB.
+ */
+constexpr int64_t INCREMENTAL_MAX_VALUE_LIMIT = 9999999;
 
-    for (int num : column2)
+/**
+ * @brief Prints the command line usage.
+ */
+void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " <input_data> [--external | --incremental [max_value]]\n";
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    bool externalMode = argc >= 3 && std::strcmp(argv[2], "--external") == 0;
+    bool incrementalMode = argc >= 3 && std::strcmp(argv[2], "--incremental") == 0;
+    if ((argc >= 3 && !externalMode && !incrementalMode) || argc > (incrementalMode ? 4 : 3)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    int64_t incrementalMaxValue = 99999; // location IDs have 5 digits
+    if (incrementalMode && argc >= 4) {
+        char *end = nullptr;
+        errno = 0;
+        incrementalMaxValue = std::strtoll(argv[3], &end, 10);
+        if (end == argv[3] || *end != '\0' || errno == ERANGE || incrementalMaxValue < 0) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (incrementalMaxValue > INCREMENTAL_MAX_VALUE_LIMIT) {
+            std::cerr << "ERROR: --incremental supports values up to " << INCREMENTAL_MAX_VALUE_LIMIT << ".\n";
+            return 1;
+        }
+    }
+
+    InputView input(filename);
+    std::vector<std::vector<int64_t>> columns(2);
+    int64_t sumOfDistances, sumOfSimilarityScores;
+
+    if (!input.isOpen())
+    {
+        std::cerr << "ERROR: Could not open the file";
+        return 1;
+    }
+
+    if (externalMode)
     {
-        count_map[num]++;
+        calculateTotalsExternal(input, sumOfDistances, sumOfSimilarityScores);
+        results() << "Sum of distances: " << sumOfDistances << '\n';
+        results() << "Sum of similarity scores: " << sumOfSimilarityScores << '\n';
+        return 0;
     }
 
-    std::vector<int> similarityScores;
+    parseIntegerColumns(input.data(), columns);
 
-    for (int num : column1)
+    if (incrementalMode)
     {
-        similarityScores.push_back(num * count_map[num]);
+        // feed the pairs one by one, in the order they were appended to the file
+        IncrementalTotals totals(incrementalMaxValue);
+        for (size_t i = 0; i < columns[0].size(); ++i)
+        {
+            if (!totals.addPair(columns[0][i], columns[1][i]))
+            {
+                std::cerr << "ERROR: Pair on line " << i + 1 << " is outside [0, " << incrementalMaxValue << "], skipped.\n";
+            }
+        }
+        results() << "Sum of distances: " << totals.sumOfDistances() << '\n';
+        results() << "Sum of similarity scores: " << totals.sumOfSimilarityScores() << '\n';
+        return 0;
     }
 
-    sumOfSimilarityScores = std::accumulate(similarityScores.begin(), similarityScores.end(), 0);
+    std::vector<int64_t> &column1 = columns[0];
+    std::vector<int64_t> &column2 = columns[1];
+
+    // spawning a second thread only pays off once the columns are big
+    radix_sort::sortColumns(column1, column2, column1.size() > (1 << 16));
+
+    sumOfDistances = calculateSumOfDistances(column1, column2);
+    sumOfSimilarityScores = calculateSimilarityScore(column1, column2);
 
-    std::cout << "Sum of distances: " << sumOfDistances << std::endl;
-    std::cout << "Sum of similarity scores: " << sumOfSimilarityScores << std::endl;
+    results() << "Sum of distances: " << sumOfDistances << '\n';
+    results() << "Sum of similarity scores: " << sumOfSimilarityScores << '\n';
 
     return 0;
 }
@@ -1,9 +1,10 @@
 #include <iostream>
-#include <fstream>
 #include <vector>
 #include <deque>
-#include <set>
-#include <map>
+
+#include "../common/grid.hpp"
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
 
 /**
  * @brief Converts a character to an integer.
@@ -27,24 +28,29 @@ int charToInt(char c)
     }
 }
 
+/**
+ * @brief Height of the grid border; it is never one above a real height, so trails cannot leave the map.
+ */
+constexpr int OUTSIDE = -1;
+
 /**
  * @brief Finds trailheads in a grid.
  *
  * This function scans a 2D grid and identifies all positions (trailheads) where the value is 0.
  *
- * @param grid The 2D grid to scan.
- * @return A vector of pairs representing the coordinates of the trailheads.
+ * @param grid The grid to scan.
+ * @return A vector with the flat indices of the trailheads.
  */
-std::vector<std::pair<int, int>> findTrailheads(const std::vector<std::vector<int>> &grid)
+std::vector<size_t> findTrailheads(const Grid<int> &grid)
 {
-    std::vector<std::pair<int, int>> trailheads;
-    for (size_t i = 0; i < grid.size(); ++i)
+    std::vector<size_t> trailheads;
+    for (int i = 0; i < grid.rows(); ++i)
     {
-        for (size_t j = 0; j < grid[i].size(); ++j)
+        for (int j = 0; j < grid.cols(); ++j)
         {
-            if (grid[i][j] == 0)
+            if (grid(i, j) == 0)
             {
-                trailheads.push_back({i, j});
+                trailheads.push_back(grid.index(i, j));
             }
         }
     }
@@ -57,47 +63,41 @@ std::vector<std::pair<int, int>> findTrailheads(const std::vector<std::vector<in
  * This function performs a Breadth-First Search (BFS) starting from a given trailhead
  * to calculate the number of hilltops (positions with value 9) reachable from that trailhead.
  *
- * @param grid The 2D grid representing the terrain.
- * @param trailhead The starting position for the BFS.
+ * @param grid The grid representing the terrain, with a border of at least one cell.
+ * @param trailhead The flat index of the starting cell.
  * @return The number of hilltops reachable from the trailhead.
  */
-int calculateScoreForTrailhead(const std::vector<std::vector<int>> &grid, const std::pair<int, int> &trailhead)
+int calculateScoreForTrailhead(const Grid<int> &grid, size_t trailhead)
 {
-    std::deque<std::pair<int, int>> Q;
-    std::set<std::pair<int, int>> visited;
+    std::deque<size_t> Q;
+    std::vector<char> visited(grid.cellCount(), 0);
     int hillTops = 0;
-    std::pair<int, int> currentItem;
+    size_t currentItem;
 
     Q.push_back(trailhead);
-    visited.insert(trailhead);
+    visited[trailhead] = 1;
 
     while (!Q.empty())
     {
         currentItem = Q.back();
         Q.pop_back();
 
-        std::set<std::pair<int, int>> neighbors = {{currentItem.first - 1, currentItem.second},
-                                                   {currentItem.first + 1, currentItem.second},
-                                                   {currentItem.first, currentItem.second - 1},
-                                                   {currentItem.first, currentItem.second + 1}};
-
-        for (const auto &[neighborRow, neighborColumn] : neighbors)
+        for (std::ptrdiff_t offset : grid.orthogonalOffsets())
         {
-            if (neighborRow < 0 || neighborColumn < 0 || neighborRow >= grid.size() || neighborColumn >= grid[0].size())
-                continue;
+            size_t neighbor = currentItem + offset;
 
-            if (grid[neighborRow][neighborColumn] != (grid[currentItem.first][currentItem.second] + 1))
+            if (grid[neighbor] != (grid[currentItem] + 1))
                 continue;
 
-            if (visited.count({neighborRow, neighborColumn}))
+            if (visited[neighbor])
                 continue;
 
-            visited.insert({neighborRow, neighborColumn});
+            visited[neighbor] = 1;
 
-            if (grid[neighborRow][neighborColumn] == 9)
+            if (grid[neighbor] == 9)
                 hillTops++;
             else
-                Q.push_front({neighborRow, neighborColumn});
+                Q.push_front(neighbor);
         }
     }
     return hillTops;
@@ -109,52 +109,46 @@ int calculateScoreForTrailhead(const std::vector<std::vector<int>> &grid, const
  * This function performs a Breadth-First Search (BFS) starting from a given trailhead
  * to calculate the number of distinct trails to reach hilltops (positions with value 9) from that trailhead.
  *
- * @param grid The 2D grid representing the terrain.
- * @param trailhead The starting position for the BFS.
+ * @param grid The grid representing the terrain, with a border of at least one cell.
+ * @param trailhead The flat index of the starting cell.
  * @return The number of distinct trails to reach hilltops from the trailhead.
  */
-int calculateRatingForTrailhead(const std::vector<std::vector<int>> &grid, const std::pair<int, int> &trailhead)
+int calculateRatingForTrailhead(const Grid<int> &grid, size_t trailhead)
 {
-    std::deque<std::pair<int, int>> Q;
-    std::map<std::pair<int, int>, int> visited;
+    std::deque<size_t> Q;
+    std::vector<int> trailsTo(grid.cellCount(), 0); // number of trails reaching each cell, 0 if not visited yet
     int numberOfTrails = 0;
-    std::pair<int, int> currentItem;
+    size_t currentItem;
 
     Q.push_back(trailhead);
-    visited.insert({trailhead, 1});
+    trailsTo[trailhead] = 1;
 
     while (!Q.empty())
     {
         currentItem = Q.back();
         Q.pop_back();
 
-        if (grid[currentItem.first][currentItem.second] == 9)
+        if (grid[currentItem] == 9)
         {
-            numberOfTrails += visited.at({currentItem.first, currentItem.second});
+            numberOfTrails += trailsTo[currentItem];
         }
 
-        std::set<std::pair<int, int>> neighbors = {{currentItem.first - 1, currentItem.second},
-                                                   {currentItem.first + 1, currentItem.second},
-                                                   {currentItem.first, currentItem.second - 1},
-                                                   {currentItem.first, currentItem.second + 1}};
-
-        for (const auto &[neighborRow, neighborColumn] : neighbors)
+        for (std::ptrdiff_t offset : grid.orthogonalOffsets())
         {
-            if (neighborRow < 0 || neighborColumn < 0 || neighborRow >= grid.size() || neighborColumn >= grid[0].size())
-                continue;
+            size_t neighbor = currentItem + offset;
 
-            if (grid[neighborRow][neighborColumn] != (grid[currentItem.first][currentItem.second] + 1))
+            if (grid[neighbor] != (grid[currentItem] + 1))
                 continue;
 
-            if (visited.count({neighborRow, neighborColumn}))
+            if (trailsTo[neighbor])
             {
-                visited.at({neighborRow, neighborColumn}) += visited.at({currentItem.first, currentItem.second});
+                trailsTo[neighbor] += trailsTo[currentItem];
                 continue;
             }
 
-            visited[{neighborRow, neighborColumn}] = visited.at({currentItem.first, currentItem.second});
+            trailsTo[neighbor] = trailsTo[currentItem];
 
-            Q.push_front({neighborRow, neighborColumn});
+            Q.push_front(neighbor);
         }
     }
     return numberOfTrails;
@@ -179,46 +173,35 @@ int main(int argc, char *argv[])
     }
 
     std::string filename = argv[1];
-    std::ifstream file(filename);
-    std::vector<std::vector<int>> grid;
-    std::string lineStr;
-    std::vector<int> line;
-    std::vector<std::pair<int, int>> trailheads;
+    InputView input(filename);
+    Grid<int> grid;
+    std::vector<size_t> trailheads;
     int sumOfScores = 0;
     int sumOfRatings = 0;
 
-    if (!file.is_open())
+    if (!input.isOpen())
     {
         std::cerr << "ERROR: Could not open the file";
         return 1;
     }
 
-    while (std::getline(file, lineStr))
-    {
-        for (const auto &ch : lineStr)
-        {
-            line.push_back(charToInt(ch));
-        }
-        grid.push_back(line);
-        line.clear();
-    }
-    file.close();
+    grid = loadGrid(input, 1, OUTSIDE, charToInt);
 
     trailheads = findTrailheads(grid);
 
     for (const auto &th : trailheads)
     {
-        std::cout << "(" << th.first << "," << th.second << ")" << std::endl;
+        LOG_DEBUG("(", grid.row(th), ",", grid.col(th), ")");
         sumOfScores += calculateScoreForTrailhead(grid, th);
         sumOfRatings += calculateRatingForTrailhead(grid, th);
     }
-    std::cout << std::endl;
+    LOG_DEBUG("");
 
     // Score is number of 9-height positions reachable from that trailhead
-    std::cout << "Sum of scores of all trailheads(Part One): " << sumOfScores << std::endl;
+    results() << "Sum of scores of all trailheads(Part One): " << sumOfScores << '\n';
 
     // Rating is number of distinct hiking trails which begin at that trailhead
-    std::cout << "Sum of ratings of all trailheads(Part Two): " << sumOfRatings << std::endl;
+    results() << "Sum of ratings of all trailheads(Part Two): " << sumOfRatings << '\n';
 
     return 0;
 }
\ No newline at end of file
@@ -1,12 +1,13 @@
 #include <iostream>
-#include <fstream>
 #include <vector>
-#include <sstream>
 #include <list> // doubly-linked list - O(1) insertion to n-th position if there
                 // is iterator to the position, otherwise O(i)
 #include <cmath>
 #include <unordered_map>
 
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+
 /**
  * @brief Splits a number into two parts by dividing its digits in half.
  *
@@ -142,31 +143,25 @@ int main(int argc, char *argv[])
 
     std::string filename = argv[1];
 
-    std::ifstream file(filename);
+    InputView input(filename);
     std::list<long long> stones;
-    std::string line;
+    std::string_view line;
 
-    if (!file.is_open())
+    if (!input.isOpen())
     {
         std::cerr << "ERROR: Could not open the file";
         return 1;
     }
 
-    std::getline(file, line);
-    std::istringstream iss(line);
+    input.nextLine(line);
+    std::string_view field;
     long long number;
-    while (iss >> number)
+    while (nextField(line, field) && parseNumber(field, number))
     {
         stones.push_back(number);
     }
 
-    file.close();
-
-    for (const auto &stone : stones)
-    {
-        std::cout << stone << " ";
-    }
-    std::cout << std::endl;
+    LOG_INFO(logging::joined(stones));
 
     int numberOfBlinks = 75;
 
@@ -176,7 +171,7 @@ int main(int argc, char *argv[])
         totalNumberOfStones += processStoneAfterBlinks(stone, numberOfBlinks);
     }
 
-    std::cout << "Number of stones after blinking " << numberOfBlinks << " times: " << totalNumberOfStones << std::endl;
+    results() << "Number of stones after blinking " << numberOfBlinks << " times: " << totalNumberOfStones << '\n';
 
     return 0;
 }
\ No newline at end of file
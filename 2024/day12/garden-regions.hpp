@@ -0,0 +1,184 @@
+#ifndef AOC_2024_DAY12_GARDEN_REGIONS_HPP
+#define AOC_2024_DAY12_GARDEN_REGIONS_HPP
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "../common/grid.hpp"
+
+/**
+ * @brief Value of the grid border; it never matches a plant.
+ */
+constexpr char OUTSIDE = '\0';
+
+/**
+ * @brief Size of the puzzle input, which gets a fixed-size grid.
+ */
+using InputShape = GridShape<140, 140>;
+
+/**
+ * @brief Calculates the perimeter of a given region.
+ *
+ * Each cell is considered as a unit square, and every side of it that borders a different
+ * plant (or the edge of the map, which holds the sentinel) is part of the perimeter.
+ *
+ * @param grid The grid of plants.
+ * @param region The flat indices of the cells in the region.
+ * @return The total perimeter of the region.
+ */
+template <typename GridT>
+long long calculatePerimeter(const GridT &grid, const std::vector<size_t> &region)
+{
+    long long perimeter = 0;
+    const auto offsets = grid.orthogonalOffsets();
+
+    for (size_t cell : region)
+    {
+        char plant = grid[cell];
+        for (std::ptrdiff_t offset : offsets)
+        {
+            perimeter += grid[cell + offset] != plant;
+        }
+    }
+    return perimeter;
+}
+
+/**
+ * @brief Counts the number of sides in a given region.
+ *
+ * A region has as many sides as corners, so this function counts corners instead. Each cell
+ * looks at its four corners; with `a` and `b` the two orthogonal neighbors next to a corner and
+ * `d` the diagonal neighbor between them, the corner is
+ * - convex when neither `a` nor `b` belongs to the region, and
+ * - concave when both do but `d` does not.
+ * Two cells of the region touching only diagonally each count their own convex corner,
+ * which gives the two sides such a point contributes.
+ *
+ * @param grid The grid of plants.
+ * @param region The flat indices of the cells in the region.
+ * @return The total number of sides in the region.
+ */
+template <typename GridT>
+long long countSides(const GridT &grid, const std::vector<size_t> &region)
+{
+    long long corners = 0;
+    // up, right, down, left; corner k lies between directions k and k + 1
+    const auto offsets = grid.orthogonalOffsets();
+
+    for (size_t cell : region)
+    {
+        char plant = grid[cell];
+        for (int k = 0; k < 4; ++k)
+        {
+            std::ptrdiff_t first = offsets[k];
+            std::ptrdiff_t second = offsets[(k + 1) % 4];
+            bool a = grid[cell + first] == plant;
+            bool b = grid[cell + second] == plant;
+            bool d = grid[cell + first + second] == plant;
+            corners += (!a && !b) || (a && b && !d);
+        }
+    }
+    return corners;
+}
+
+/**
+ * @brief Finds all contiguous regions of the same type of plant in a grid.
+ *
+ * @param grid The grid of plants, with a border of at least one cell.
+ * @return The flat indices of the cells of every region.
+ */
+template <typename GridT>
+std::vector<std::vector<size_t>> findRegions(const GridT &grid)
+{
+    std::vector<std::vector<size_t>> allRegions;
+    std::vector<size_t> region;
+    std::vector<char> visited(grid.cellCount(), 0);
+    std::deque<size_t> Q;
+    size_t currentPosition;
+    char plant;
+
+    for (int i = 0; i < grid.rows(); ++i)
+    {
+        for (int j = 0; j < grid.cols(); ++j)
+        {
+            size_t position = grid.index(i, j);
+
+            if (visited[position])
+            {
+                continue;
+            }
+            region.clear();
+            region.push_back(position);
+            visited[position] = 1;
+            Q.push_front(position);
+
+            plant = grid[position];
+
+            while (!Q.empty())
+            {
+                currentPosition = Q.back();
+                Q.pop_back();
+
+                for (std::ptrdiff_t offset : grid.orthogonalOffsets())
+                {
+                    size_t neighbor = currentPosition + offset;
+                    // the border never matches a plant, so the fill stops at the edge of the map
+                    if (grid[neighbor] != plant)
+                    {
+                        continue;
+                    }
+                    if (visited[neighbor])
+                    {
+                        continue;
+                    }
+                    region.push_back(neighbor);
+                    visited[neighbor] = 1;
+                    Q.push_front(neighbor);
+                }
+            }
+            allRegions.push_back(region);
+        }
+    }
+    return allRegions;
+}
+
+/**
+ * @brief Calculates the total price of fences required for all regions in a grid.
+ *
+ * The price of a region is its size times its perimeter.
+ *
+ * @param grid The grid of plants, with a border of at least one cell.
+ * @return The total price of fences.
+ */
+template <typename GridT>
+long long calculatePriceOfFences(const GridT &grid)
+{
+    long long priceOfFences = 0;
+    for (const auto &reg : findRegions(grid))
+    {
+        priceOfFences += reg.size() * calculatePerimeter(grid, reg);
+    }
+    return priceOfFences;
+}
+
+/**
+ * @brief Calculates the total price of fences with the bulk discount.
+ *
+ * The price of a region is its size times its number of sides.
+ *
+ * @param grid The grid of plants, with a border of at least one cell.
+ * @return The total price of fences.
+ */
+template <typename GridT>
+long long calculateDiscountedPriceOfFences(const GridT &grid)
+{
+    long long priceOfFences = 0;
+    for (const auto &reg : findRegions(grid))
+    {
+        priceOfFences += reg.size() * countSides(grid, reg);
+    }
+    return priceOfFences;
+}
+
+#endif // AOC_2024_DAY12_GARDEN_REGIONS_HPP
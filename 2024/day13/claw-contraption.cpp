@@ -1,10 +1,12 @@
 #include <iostream>
-#include <fstream>
 #include <vector>
 #include <string>
 #include <regex>
 #include <climits> //LLONG_MAX
 
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+
 /**
  * @brief Calculates the minimum number of tokens required to win all possible prizes.
  *
@@ -81,7 +83,7 @@ long long calculateMinNumberOfTokensOptimized(const std::vector<std::vector<long
 
             if ((px * by - py * bx) % determinant == 0 && (px - ax * countOfAPresses) % bx == 0)
             {
-                std::cout << "P " << countOfAPresses << " " << countOfBPresses << std::endl;
+                LOG_DEBUG("P ", countOfAPresses, " ", countOfBPresses);
                 minTokensSum += countOfAPresses * 3 + countOfBPresses;
             }
         }
@@ -110,21 +112,21 @@ int main(int argc, char *argv[])
     }
 
     std::string filename = argv[1];
-    std::ifstream file(filename);
-    std::string line;
+    InputView input(filename);
+    std::string_view line;
     std::regex numbersRegex(R"(\d+)");
     std::vector<std::vector<long long>> numberGroups;
     std::vector<long long> numbers;
     long long minNumberOfTokens = 0;
     long long minNumberOfTokensP2 = 0;
 
-    if (!file.is_open())
+    if (!input.isOpen())
     {
         std::cerr << "ERROR: Could not open the file";
         return 1;
     }
 
-    while (std::getline(file, line))
+    while (input.nextLine(line))
     {
         if (line.empty())
         {
@@ -136,12 +138,16 @@ int main(int argc, char *argv[])
         }
         else
         {
-            auto begin = std::sregex_iterator(line.begin(), line.end(), numbersRegex);
-            auto end = std::sregex_iterator();
+            auto begin = std::cregex_iterator(line.data(), line.data() + line.size(), numbersRegex);
+            auto end = std::cregex_iterator();
 
-            for (std::regex_iterator i = begin; i != end; ++i)
+            for (std::cregex_iterator i = begin; i != end; ++i)
             {
-                numbers.push_back(std::stoll((*i).str()));
+                long long number;
+                if (parseNumber(std::string_view((*i)[0].first, (*i)[0].length()), number))
+                {
+                    numbers.push_back(number);
+                }
             }
         }
     }
@@ -149,24 +155,19 @@ int main(int argc, char *argv[])
     {
         numberGroups.push_back(numbers);
     }
-    file.close();
 
     for (const auto &numList : numberGroups)
     {
-        for (const auto &num : numList)
-        {
-            std::cout << num << " ";
-        }
-        std::cout << std::endl;
+        LOG_DEBUG(logging::joined(numList));
     }
 
     minNumberOfTokens = calculateMinNumberOfTokens(numberGroups);
 
-    std::cout << "The fewest tokens you would have to spend to will all posible prizes is(Part 1): " << minNumberOfTokens << std::endl;
+    results() << "The fewest tokens you would have to spend to will all posible prizes is(Part 1): " << minNumberOfTokens << '\n';
 
     minNumberOfTokensP2 = calculateMinNumberOfTokensOptimized(numberGroups);
 
-    std::cout << "The fewest tokens you would have to spend to will all posible prizes is(Part 2): " << minNumberOfTokensP2 << std::endl;
+    results() << "The fewest tokens you would have to spend to will all posible prizes is(Part 2): " << minNumberOfTokensP2 << '\n';
 
     return 0;
 }
@@ -1,125 +1,85 @@
 #include <iostream>
-#include <fstream>
 #include <vector>
-#include <sstream>
+#include <cstdint>
+#include <cstring>
 
-bool isAscendingOrDescendingWithProperDifference(std::vector<int> vector, int elementToSkip = 99)
-{
-    int diff;
-    std::string direction;
-    for (size_t i = 1; i < vector.size(); ++i)
-    {
-        if (i == elementToSkip)
-        {
-            continue;
-        }
-
-        if (vector[i] == vector[i - 1])
-            return false;
-
-        if (direction.empty())
-        {
-            if (vector[i] > vector[i - 1]) // ascending
-            {
-                direction = "ascending";
-            }
-            else
-            {
-                direction = "descending";
-            }
-        }
-
-        diff = std::abs(vector[i] - vector[i - 1]);
+#include "../common/command-line.hpp"
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+#include "../common/number-parser.hpp"
+#include "report-checks.hpp"
 
-        if (direction.compare("ascending") == 0)
-        {
-            if (elementToSkip != i - 1)
-            {
-                if (vector[i] < vector[i - 1])
-                    return false;
-            }
-            else
-            { // usecase 52 53 54 56 59 61 65 63
-                if (vector[i] < vector[i - 2])
-                    return false;
-            }
-        }
-        else if (direction.compare("descending") == 0)
-        {
-            if (elementToSkip != i - 1)
-            {
-                if (vector[i] > vector[i - 1])
-                    return false;
-            }
-            else
-            {
-                if (vector[i] > vector[i - 2])
-                    return false;
-            }
-        }
-
-        if (diff < 1 || diff > 3)
-            return false;
-    }
-    return true;
+/**
+ * @brief Prints the command line usage.
+ */
+void printUsage(const char *program)
+{
+    std::cerr << "Usage: " << program << " <input_data> [--tolerance k]\n";
 }
 
 int main(int argc, char *argv[]) {
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <input_data>" << std::endl;
+        printUsage(argv[0]);
         return 1;
     }
 
     std::string filename = argv[1];
+    bool toleranceMode = argc >= 3 && std::strcmp(argv[2], "--tolerance") == 0;
+    size_t tolerance = 0;
+    if (toleranceMode && (argc < 4 || !command_line::parseCount(argv[3], tolerance)))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
 
-    std::ifstream file(filename);
-    std::vector<std::vector<int>> data;
-    std::string line;
+    InputView input(filename);
+    Reports data;
+    std::vector<int64_t> levels;
+    std::vector<uint8_t> safe;
     uint32_t number_of_safe_reports = 0;
     uint32_t number_of_safe_reports_with_problem_dampener = 0;
 
-    if (!file.is_open())
+    if (!input.isOpen())
     {
         std::cerr << "ERROR: Could not open the file";
         return 1;
     }
 
-    while (std::getline(file, line))
-    {
-        std::istringstream iss(line);
-        std::vector<int> numbers;
-        int number;
-        while (iss >> number)
-        {
-            numbers.push_back(number);
-        }
-        data.push_back(numbers);
-    }
+    data.offsets.clear();
+    parseIntegers(input.data(), levels, &data.offsets);
+    data.levels.assign(levels.begin(), levels.end());
 
-    file.close();
+    validateReports(data, safe);
 
-    for (const auto &line : data)
+    for (size_t r = 0; r < data.size(); ++r)
     {
-        if (isAscendingOrDescendingWithProperDifference(line))
+        if (safe[r])
         {
             number_of_safe_reports++;
         }
-        else
+        else if (isSafeWithOneRemoval(data[r]))
+        {
+            number_of_safe_reports_with_problem_dampener++;
+        }
+    }
+
+    if (toleranceMode)
+    {
+        std::vector<size_t> minRemovals;
+        uint32_t number_of_safe_reports_with_tolerance = 0;
+        for (size_t r = 0; r < data.size(); ++r)
         {
-            for (size_t i = 0; i < line.size(); ++i)
+            if (isSafeWithRemovals(data[r], tolerance, minRemovals))
             {
-                if (isAscendingOrDescendingWithProperDifference(line, i))
-                {
-                    number_of_safe_reports_with_problem_dampener++;
-                    break;
-                }
+                number_of_safe_reports_with_tolerance++;
             }
         }
+        results() << "Number of safe reports when tolerating " << tolerance << " bad levels: " << number_of_safe_reports_with_tolerance << '\n';
     }
 
-    std::cout << "Number of reports: " << data.size() << std::endl;
-    std::cout << "Number of safe reports: " << number_of_safe_reports << std::endl;
-    std::cout << "Number of safe reports when using Problem Dampener: " << number_of_safe_reports + number_of_safe_reports_with_problem_dampener << std::endl;
+    results() << "Number of reports: " << data.size() << '\n';
+    results() << "Number of safe reports: " << number_of_safe_reports << '\n';
+    results() << "Number of safe reports when using Problem Dampener: " << number_of_safe_reports + number_of_safe_reports_with_problem_dampener << '\n';
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,297 @@
+#ifndef AOC_2024_DAY2_REPORT_CHECKS_HPP
+#define AOC_2024_DAY2_REPORT_CHECKS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Non-owning view of the levels of one report.
+ */
+struct Report
+{
+    const int *levels;
+    size_t count;
+
+    Report(const int *levels, size_t count) : levels(levels), count(count) {}
+    Report(const std::vector<int> &levels) : levels(levels.data()), count(levels.size()) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    int operator[](size_t i) const { return levels[i]; }
+};
+
+/**
+ * @brief All reports in compressed sparse row form.
+ *
+ * The levels of all reports are stored back to back in one array, report r being
+ * levels[offsets[r] .. offsets[r + 1]). This needs two allocations in total instead
+ * of one per report.
+ */
+struct Reports
+{
+    std::vector<int> levels;
+    std::vector<size_t> offsets{0};
+
+    size_t size() const { return offsets.size() - 1; }
+    Report operator[](size_t r) const { return Report(levels.data() + offsets[r], offsets[r + 1] - offsets[r]); }
+
+    void add(const std::vector<int> &report)
+    {
+        levels.insert(levels.end(), report.begin(), report.end());
+        offsets.push_back(levels.size());
+    }
+};
+
+/**
+ * @brief Direction a safe report has to follow.
+ */
+enum Direction
+{
+    DESCENDING = -1,
+    ASCENDING = 1
+};
+
+/**
+ * @brief Checks if going from `previous` to `next` is a safe step in the given direction.
+ *
+ * A safe step moves in `direction` by at least 1 and at most 3.
+ */
+inline bool isSafeStep(int previous, int next, Direction direction)
+{
+    int diff = (next - previous) * direction;
+    return diff >= 1 && diff <= 3;
+}
+
+/**
+ * @brief Checks if a report is safe, optionally ignoring one level.
+ *
+ * @param report The levels of the report.
+ * @param direction The direction the levels have to follow.
+ * @param elementToSkip Index of the level to ignore, or SIZE_MAX to ignore none.
+ * @return true if every step between the remaining levels is safe.
+ */
+inline bool isSafeInDirection(Report report, Direction direction, size_t elementToSkip)
+{
+    size_t previous = elementToSkip == 0 ? 1 : 0;
+    for (size_t i = previous + 1; i < report.size(); ++i)
+    {
+        if (i == elementToSkip)
+            continue;
+        if (!isSafeStep(report[previous], report[i], direction))
+            return false;
+        previous = i;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks if a report is safe: strictly ascending or descending by 1 to 3 at every step.
+ *
+ * @param report The levels of the report.
+ * @param elementToSkip Index of a level to ignore, or SIZE_MAX (default) to ignore none.
+ */
+inline bool isSafeReport(Report report, size_t elementToSkip = SIZE_MAX)
+{
+    return isSafeInDirection(report, ASCENDING, elementToSkip) || isSafeInDirection(report, DESCENDING, elementToSkip);
+}
+
+/**
+ * @brief Reference Problem Dampener: retries the report once per removed level, O(n^2).
+ */
+inline bool isSafeWithOneRemovalBruteForce(Report report)
+{
+    for (size_t i = 0; i < report.size(); ++i)
+    {
+        if (isSafeReport(report, i))
+            return true;
+    }
+    return report.empty();
+}
+
+/**
+ * @brief Single pass Problem Dampener for one direction, O(n).
+ *
+ * prefixEnd is the last index such that report[0..prefixEnd] is safe and suffixStart the first
+ * index such that report[suffixStart..n-1] is safe. Removing level k works exactly when the levels
+ * before it and after it are both safe (k - 1 <= prefixEnd and k + 1 >= suffixStart) and the
+ * neighbours of k form a safe step, so only k in [suffixStart - 1, prefixEnd + 1] has to be checked.
+ */
+inline bool isSafeWithOneRemovalInDirection(Report report, Direction direction)
+{
+    size_t n = report.size();
+    if (n <= 2)
+        return true;
+
+    size_t prefixEnd = 0;
+    while (prefixEnd + 1 < n && isSafeStep(report[prefixEnd], report[prefixEnd + 1], direction))
+        prefixEnd++;
+    if (prefixEnd == n - 1)
+        return true; // already safe, removing the last level keeps it safe
+
+    size_t suffixStart = n - 1;
+    while (suffixStart > 0 && isSafeStep(report[suffixStart - 1], report[suffixStart], direction))
+        suffixStart--;
+
+    // both the prefix and the suffix stop at a bad step, so the candidates are a handful of indices
+    size_t first = suffixStart == 0 ? 0 : suffixStart - 1;
+    size_t last = std::min(prefixEnd + 1, n - 1);
+    for (size_t k = first; k <= last; ++k)
+    {
+        bool prefixSafe = k == 0 || k - 1 <= prefixEnd;
+        bool suffixSafe = k == n - 1 || k + 1 >= suffixStart;
+        bool bridgeSafe = k == 0 || k == n - 1 || isSafeStep(report[k - 1], report[k + 1], direction);
+        if (prefixSafe && suffixSafe && bridgeSafe)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Checks if a report is safe after removing at most one level, in O(n).
+ */
+inline bool isSafeWithOneRemoval(Report report)
+{
+    return isSafeWithOneRemovalInDirection(report, ASCENDING) || isSafeWithOneRemovalInDirection(report, DESCENDING);
+}
+
+/**
+ * @brief Minimum number of levels to remove so the report becomes safe in one direction, O(n * k).
+ *
+ * minRemovals[i] is the fewest removals among the levels before i such that level i is kept and
+ * all kept levels up to i form safe steps. Since at most k levels may be removed, the previous kept
+ * level is one of the k + 1 levels right before i:
+ *     minRemovals[i] = min over g in [0, k] of minRemovals[i - 1 - g] + g, if that step is safe
+ * and keeping i as the first level costs i removals. The answer is the minimum of
+ * minRemovals[i] + (n - 1 - i), i.e. with every level after i removed.
+ *
+ * @param report The levels of the report.
+ * @param direction The direction the kept levels have to follow.
+ * @param maxRemovals The tolerance k.
+ * @param minRemovals Scratch buffer, reused between calls to avoid allocations.
+ * @return The minimum number of removals, or maxRemovals + 1 if more than maxRemovals are needed.
+ */
+inline size_t minimumRemovalsInDirection(Report report, Direction direction, size_t maxRemovals, std::vector<size_t> &minRemovals)
+{
+    size_t n = report.size();
+    size_t tooMany = maxRemovals + 1;
+    if (n <= 1)
+        return 0; // a single level is always safe
+
+    minRemovals.assign(n, tooMany);
+    size_t best = tooMany;
+    for (size_t i = 0; i < n; ++i)
+    {
+        size_t removals = i <= maxRemovals ? i : tooMany;
+        for (size_t gap = 0; gap <= maxRemovals && gap < i; ++gap)
+        {
+            size_t previous = i - 1 - gap;
+            if (minRemovals[previous] + gap < removals && isSafeStep(report[previous], report[i], direction))
+                removals = minRemovals[previous] + gap;
+        }
+        minRemovals[i] = removals;
+        if (n - 1 - i <= maxRemovals)
+            best = std::min(best, removals + (n - 1 - i));
+    }
+    return std::min(best, tooMany);
+}
+
+/**
+ * @brief Checks if a report can be made safe by removing at most `maxRemovals` levels.
+ */
+inline bool isSafeWithRemovals(Report report, size_t maxRemovals, std::vector<size_t> &minRemovals)
+{
+    return minimumRemovalsInDirection(report, ASCENDING, maxRemovals, minRemovals) <= maxRemovals ||
+           minimumRemovalsInDirection(report, DESCENDING, maxRemovals, minRemovals) <= maxRemovals;
+}
+
+constexpr uint8_t SAFE_ASCENDING = 1;
+constexpr uint8_t SAFE_DESCENDING = 2;
+
+/**
+ * @brief Classifies every step between neighbouring levels of the flat level array.
+ *
+ * steps[i] describes levels[i] -> levels[i + 1]: bit SAFE_ASCENDING is set if the step goes up
+ * by 1..3, bit SAFE_DESCENDING if it goes down by 1..3. The whole array is processed in one pass,
+ * 16 steps at a time with SSE2; steps that cross from one report into the next are classified
+ * too but never read.
+ */
+inline void classifySteps(const std::vector<int> &levels, std::vector<uint8_t> &steps)
+{
+    size_t numberOfSteps = levels.empty() ? 0 : levels.size() - 1;
+    steps.resize(numberOfSteps);
+    const int *level = levels.data();
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i four = _mm_set1_epi32(4);
+    const __m128i minusFour = _mm_set1_epi32(-4);
+    const __m128i ascendingBit = _mm_set1_epi8(SAFE_ASCENDING);
+    const __m128i descendingBit = _mm_set1_epi8(SAFE_DESCENDING);
+
+    auto classify4 = [&](size_t at, __m128i &ascending, __m128i &descending)
+    {
+        __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i *>(level + at));
+        __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i *>(level + at + 1));
+        __m128i diff = _mm_sub_epi32(next, current);
+        ascending = _mm_and_si128(_mm_cmpgt_epi32(diff, zero), _mm_cmplt_epi32(diff, four));
+        descending = _mm_and_si128(_mm_cmplt_epi32(diff, zero), _mm_cmpgt_epi32(diff, minusFour));
+    };
+
+    for (; i + 16 <= numberOfSteps; i += 16)
+    {
+        __m128i a0, a1, a2, a3, d0, d1, d2, d3;
+        classify4(i, a0, d0);
+        classify4(i + 4, a1, d1);
+        classify4(i + 8, a2, d2);
+        classify4(i + 12, a3, d3);
+        // narrow the 32-bit lane masks down to one byte per step
+        __m128i ascending = _mm_packs_epi16(_mm_packs_epi32(a0, a1), _mm_packs_epi32(a2, a3));
+        __m128i descending = _mm_packs_epi16(_mm_packs_epi32(d0, d1), _mm_packs_epi32(d2, d3));
+        __m128i flags = _mm_or_si128(_mm_and_si128(ascending, ascendingBit), _mm_and_si128(descending, descendingBit));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(steps.data() + i), flags);
+    }
+#endif
+
+    for (; i < numberOfSteps; ++i)
+    {
+        int diff = level[i + 1] - level[i];
+        steps[i] = (diff >= 1 && diff <= 3 ? SAFE_ASCENDING : 0) | (diff >= -3 && diff <= -1 ? SAFE_DESCENDING : 0);
+    }
+}
+
+/**
+ * @brief Validates all reports at once.
+ *
+ * After classifySteps, a report is safe if all of its steps share the ascending bit or all share
+ * the descending bit, so validating it is an AND over a contiguous byte range.
+ *
+ * @param reports The reports to validate.
+ * @param safe Set to 1 for every safe report, 0 otherwise.
+ */
+inline void validateReports(const Reports &reports, std::vector<uint8_t> &safe)
+{
+    std::vector<uint8_t> steps;
+    classifySteps(reports.levels, steps);
+
+    safe.resize(reports.size());
+    for (size_t r = 0; r < reports.size(); ++r)
+    {
+        size_t first = reports.offsets[r];
+        size_t last = reports.offsets[r + 1];
+        uint8_t common = SAFE_ASCENDING | SAFE_DESCENDING;
+        for (size_t i = first; i + 1 < last; ++i)
+        {
+            common &= steps[i];
+        }
+        safe[r] = common != 0;
+    }
+}
+
+#endif // AOC_2024_DAY2_REPORT_CHECKS_HPP
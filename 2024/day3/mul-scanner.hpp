@@ -0,0 +1,405 @@
+#ifndef AOC_2024_DAY3_MUL_SCANNER_HPP
+#define AOC_2024_DAY3_MUL_SCANNER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MUL_SCANNER_X86 1
+#endif
+
+/**
+ * @brief Prefilter that jumps straight to the bytes that can start a token ('m' or 'd').
+ *
+ * Most bytes of the input cannot start a token. The vector versions compare 32 (AVX2) or
+ * 16 (SSE2) bytes at once against 'm' and 'd' and use the movemask of the result to jump to
+ * the first candidate. The AVX2 version is compiled with a target attribute and picked at
+ * runtime if the CPU supports it, so the binary does not need to be built with -mavx2.
+ */
+namespace candidate_filter
+{
+    using FindFunction = const char *(*)(const char *, const char *);
+
+    /**
+     * @brief Returns the first 'm' or 'd' in [p, end), or end if there is none.
+     */
+    inline const char *findScalar(const char *p, const char *end)
+    {
+        while (p < end && *p != 'm' && *p != 'd')
+            ++p;
+        return p;
+    }
+
+#if defined(MUL_SCANNER_X86)
+    __attribute__((target("avx2"))) inline const char *findAvx2(const char *p, const char *end)
+    {
+        const __m256i m = _mm256_set1_epi8('m');
+        const __m256i d = _mm256_set1_epi8('d');
+        for (; p + 32 <= end; p += 32)
+        {
+            __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, m), _mm256_cmpeq_epi8(bytes, d))));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+        }
+        return findScalar(p, end);
+    }
+
+    __attribute__((target("sse2"))) inline const char *findSse2(const char *p, const char *end)
+    {
+        const __m128i m = _mm_set1_epi8('m');
+        const __m128i d = _mm_set1_epi8('d');
+        for (; p + 16 <= end; p += 16)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes, m), _mm_cmpeq_epi8(bytes, d))));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+        }
+        return findScalar(p, end);
+    }
+#endif
+
+    /**
+     * @brief Picks the widest implementation the CPU supports.
+     */
+    inline FindFunction selectFind()
+    {
+#if defined(MUL_SCANNER_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return findAvx2;
+        if (__builtin_cpu_supports("sse2"))
+            return findSse2;
+#endif
+        return findScalar;
+    }
+
+    /**
+     * @brief Returns the first 'm' or 'd' in [p, end), or end if there is none.
+     */
+    inline const char *findCandidate(const char *p, const char *end)
+    {
+        static const FindFunction find = selectFind();
+        return find(p, end);
+    }
+}
+
+/**
+ * @brief Single pass state machine recognizing "mul(a,b)", "do()" and "don't()".
+ *
+ * a and b are numbers of 1 to 3 digits. Every byte is looked at once; when a byte does not
+ * continue the current token, the scanner falls back to the start state and examines the same
+ * byte again, which is enough because 'm' and 'd' never appear inside a token after its first
+ * character.
+ *
+ * The state is kept between calls to scan(), so the input can be fed in pieces and a token may
+ * straddle two pieces.
+ */
+class MulScanner
+{
+public:
+    /**
+     * @brief Scans the next piece of the input.
+     */
+    void scan(std::string_view data)
+    {
+        const char *p = data.data();
+        const char *end = p + data.size();
+
+        while (p < end)
+        {
+            if (state_ == START)
+            {
+                // fast path: nothing but 'm' and 'd' can start a token
+                p = candidate_filter::findCandidate(p, end);
+                if (p == end)
+                    break;
+            }
+
+            if (step(*p))
+                ++p;
+        }
+    }
+
+    /**
+     * @brief Finishes a token that was started but not completed by the last scan().
+     *
+     * Bytes of `following` are consumed only while they continue that token; scanning stops at
+     * the first byte that would start or belong to a new token. Used to let a chunk own the
+     * tokens starting inside it even when they straddle the chunk end.
+     */
+    void finishPendingToken(std::string_view following)
+    {
+        for (char c : following)
+        {
+            if (state_ == START || !step(c) || state_ == START)
+                break;
+        }
+        if (state_ != START)
+            reset(); // the token is cut off by the end of the input
+    }
+
+    /**
+     * @brief Sum of all products (part 1).
+     */
+    int64_t sumOfAllProducts() const { return sumOfAllProducts_; }
+
+    /**
+     * @brief Sum of the products found while multiplications were enabled (part 2).
+     */
+    int64_t sumOfEnabledProducts() const { return sumOfEnabledProducts_; }
+
+    /**
+     * @brief Sum of the products found before the first "do()" or "don't()".
+     */
+    int64_t sumBeforeFirstToggle() const { return sumBeforeFirstToggle_; }
+
+    /**
+     * @brief Whether a "do()" or "don't()" was seen.
+     */
+    bool hasToggle() const { return hasToggle_; }
+
+    /**
+     * @brief Whether multiplications are enabled at the current position.
+     */
+    bool isEnabled() const { return enabled_; }
+
+    /**
+     * @brief Sets whether multiplications are enabled, e.g. to start in the disabled state.
+     */
+    void setEnabled(bool enabled) { enabled_ = enabled; }
+
+private:
+    enum State
+    {
+        START,
+        M,
+        MU,
+        MUL,
+        FIRST_NUMBER,
+        SECOND_NUMBER,
+        D,
+        DO,
+        DO_OPEN,
+        DON,
+        DON_APOSTROPHE,
+        DON_T,
+        DON_T_OPEN
+    };
+
+    static bool isDigit(char c) { return static_cast<unsigned char>(c - '0') <= 9; }
+
+    /**
+     * @brief Advances the state machine by one byte.
+     *
+     * @return true if the byte was consumed, false if it has to be examined again from START.
+     */
+    bool step(char c)
+    {
+        switch (state_)
+        {
+        case START:
+            state_ = c == 'm' ? M : (c == 'd' ? D : START);
+            return true;
+        case M:
+            return expect(c == 'u', MU);
+        case MU:
+            return expect(c == 'l', MUL);
+        case MUL:
+            return expect(c == '(', FIRST_NUMBER);
+        case FIRST_NUMBER:
+            if (isDigit(c) && digits_ < 3)
+            {
+                first_ = first_ * 10 + (c - '0');
+                digits_++;
+                return true;
+            }
+            if (c == ',' && digits_ > 0)
+            {
+                digits_ = 0;
+                state_ = SECOND_NUMBER;
+                return true;
+            }
+            return reset();
+        case SECOND_NUMBER:
+            if (isDigit(c) && digits_ < 3)
+            {
+                second_ = second_ * 10 + (c - '0');
+                digits_++;
+                return true;
+            }
+            if (c == ')' && digits_ > 0)
+            {
+                int64_t product = first_ * second_;
+                sumOfAllProducts_ += product;
+                if (enabled_)
+                    sumOfEnabledProducts_ += product;
+                if (!hasToggle_)
+                    sumBeforeFirstToggle_ += product;
+                reset();
+                return true;
+            }
+            return reset();
+        case D:
+            return expect(c == 'o', DO);
+        case DO:
+            if (c == '(')
+                return expect(true, DO_OPEN);
+            return expect(c == 'n', DON);
+        case DO_OPEN:
+            if (c == ')')
+            {
+                enabled_ = true;
+                hasToggle_ = true;
+                reset();
+                return true;
+            }
+            return reset();
+        case DON:
+            return expect(c == '\'', DON_APOSTROPHE);
+        case DON_APOSTROPHE:
+            return expect(c == 't', DON_T);
+        case DON_T:
+            return expect(c == '(', DON_T_OPEN);
+        case DON_T_OPEN:
+            if (c == ')')
+            {
+                enabled_ = false;
+                hasToggle_ = true;
+                reset();
+                return true;
+            }
+            return reset();
+        }
+        return reset();
+    }
+
+    /**
+     * @brief Moves to `next` if `matches`, otherwise drops the partial token.
+     */
+    bool expect(bool matches, State next)
+    {
+        if (!matches)
+            return reset();
+        state_ = next;
+        return true;
+    }
+
+    /**
+     * @brief Drops the partial token and returns to START.
+     *
+     * @return false, so the current byte is examined again from START.
+     */
+    bool reset()
+    {
+        state_ = START;
+        first_ = 0;
+        second_ = 0;
+        digits_ = 0;
+        return false;
+    }
+
+    State state_ = START;
+    int64_t first_ = 0;
+    int64_t second_ = 0;
+    int digits_ = 0;
+    bool enabled_ = true;
+    bool hasToggle_ = false;
+    int64_t sumOfAllProducts_ = 0;
+    int64_t sumOfEnabledProducts_ = 0;
+    int64_t sumBeforeFirstToggle_ = 0;
+};
+
+/**
+ * @brief Result of scanning one chunk without knowing the enable state at its start.
+ *
+ * Summaries of neighbouring chunks are merged with combine(), which is associative, so the
+ * chunks can be scanned independently and reduced in order at the end.
+ */
+struct ChunkSummary
+{
+    int64_t sumOfAllProducts = 0;
+    int64_t sumIfStartEnabled = 0;  ///< enabled products if the chunk starts enabled
+    int64_t sumIfStartDisabled = 0; ///< enabled products if the chunk starts disabled
+    bool hasToggle = false;         ///< whether the chunk contains "do()" or "don't()"
+    bool finalEnabled = true;       ///< state at the chunk end, meaningful only if hasToggle
+
+    /**
+     * @brief Summary of chunk `first` directly followed by chunk `second`.
+     */
+    static ChunkSummary combine(const ChunkSummary &first, const ChunkSummary &second)
+    {
+        ChunkSummary combined;
+        combined.sumOfAllProducts = first.sumOfAllProducts + second.sumOfAllProducts;
+        int64_t secondIfFirstStartsEnabled = (!first.hasToggle || first.finalEnabled) ? second.sumIfStartEnabled : second.sumIfStartDisabled;
+        int64_t secondIfFirstStartsDisabled = (first.hasToggle && first.finalEnabled) ? second.sumIfStartEnabled : second.sumIfStartDisabled;
+        combined.sumIfStartEnabled = first.sumIfStartEnabled + secondIfFirstStartsEnabled;
+        combined.sumIfStartDisabled = first.sumIfStartDisabled + secondIfFirstStartsDisabled;
+        combined.hasToggle = first.hasToggle || second.hasToggle;
+        combined.finalEnabled = second.hasToggle ? second.finalEnabled : first.finalEnabled;
+        return combined;
+    }
+};
+
+/**
+ * @brief Scans `data[from, to)`, owning every token that starts in that range.
+ */
+inline ChunkSummary scanChunk(std::string_view data, size_t from, size_t to)
+{
+    MulScanner scanner;
+    scanner.scan(data.substr(from, to - from));
+    scanner.finishPendingToken(data.substr(to));
+
+    ChunkSummary summary;
+    summary.sumOfAllProducts = scanner.sumOfAllProducts();
+    summary.sumIfStartEnabled = scanner.sumOfEnabledProducts();
+    // products after the first toggle do not depend on the state at the chunk start
+    summary.sumIfStartDisabled = scanner.sumOfEnabledProducts() - scanner.sumBeforeFirstToggle();
+    summary.hasToggle = scanner.hasToggle();
+    summary.finalEnabled = scanner.isEnabled();
+    return summary;
+}
+
+/**
+ * @brief Scans the input split into chunks on several threads.
+ *
+ * @param data The whole input.
+ * @param numberOfThreads How many chunks to scan in parallel, at most one per core; 0 picks
+ *                        one per core, limited so that every chunk has at least 1 MB.
+ * @return The summary of the whole input; read sumIfStartEnabled for part 2.
+ */
+inline ChunkSummary scanParallel(std::string_view data, size_t numberOfThreads = 0)
+{
+    constexpr size_t MIN_CHUNK_SIZE = 1 << 20;
+    size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    if (numberOfThreads == 0)
+    {
+        numberOfThreads = std::min(cores, data.size() / MIN_CHUNK_SIZE + 1);
+    }
+    numberOfThreads = std::min(numberOfThreads, cores); // more threads than cores only add switching
+
+    std::vector<ChunkSummary> summaries(numberOfThreads);
+    std::vector<std::thread> workers;
+    size_t chunkSize = data.size() / numberOfThreads + 1;
+    for (size_t t = 0; t < numberOfThreads; ++t)
+    {
+        size_t from = std::min(data.size(), t * chunkSize);
+        size_t to = std::min(data.size(), from + chunkSize);
+        workers.emplace_back([&summaries, data, t, from, to]() { summaries[t] = scanChunk(data, from, to); });
+    }
+
+    ChunkSummary total; // an empty chunk is the identity of combine()
+    for (size_t t = 0; t < numberOfThreads; ++t)
+    {
+        workers[t].join();
+        total = ChunkSummary::combine(total, summaries[t]);
+    }
+    return total;
+}
+
+#endif // AOC_2024_DAY3_MUL_SCANNER_HPP
@@ -1,54 +1,48 @@
 #include <iostream>
-#include <fstream>
-#include <vector>
-#include <sstream>
-#include <regex>
+#include <cstring>
+#include <string>
 
-int main()
-{
-    std::ifstream file("input_data");
+#include "../common/command-line.hpp"
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+#include "mul-scanner.hpp"
 
-    if (!file.is_open())
+int main(int argc, char *argv[])
+{
+    std::string filename = "input_data";
+    size_t numberOfThreads = 0; // one per core, for inputs big enough to be worth splitting
+    for (int i = 1; i < argc; ++i)
     {
-        std::cerr << "Unable to open file" << std::endl;
-        return 1;
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc && command_line::parseCount(argv[i + 1], numberOfThreads) && numberOfThreads > 0)
+        {
+            ++i;
+        }
+        else if (i == 1 && argv[i][0] != '-')
+        {
+            filename = argv[i];
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [input_data] [--threads N]" << std::endl;
+            return 1;
+        }
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string data = buffer.str();
-
-    file.close();
+    InputView input(filename);
 
-    std::cout << "Memory data:" << data << std::endl;
-
-    std::regex pattern(R"(mul\((\d{1,3}),(\d{1,3})\))");
-    std::vector<std::string> parsed_data;
-
-    auto begin = std::sregex_iterator(data.begin(), data.end(), pattern);
-    auto end = std::sregex_iterator();
-    std::smatch match1, match2;
-
-    for (std::sregex_iterator i = begin; i != end; ++i)
+    if (!input.isOpen())
     {
-        match1 = *i;
-        parsed_data.push_back(match1.str());
+        std::cerr << "Unable to open file" << std::endl;
+        return 1;
     }
 
-    int total_sum = 0;
+    std::string_view data = input.data();
 
-    for (const auto &s : parsed_data)
-    {
-        if (std::regex_match(s, match2, pattern))
-        {
-            // LOG("Match1:", match2[0].str());
-            int num1 = std::stoi(match2[1].str());
-            int num2 = std::stoi(match2[2].str());
-            total_sum += num1 * num2;
-        }
-    }
+    LOG_DEBUG("Memory data:", data);
+
+    ChunkSummary summary = scanParallel(data, numberOfThreads);
 
-    std::cout << "The total sum of all multiplications is: " << total_sum << std::endl;
+    results() << "The total sum of all multiplications is: " << summary.sumOfAllProducts << '\n';
 
     return 0;
-}
\ No newline at end of file
+}
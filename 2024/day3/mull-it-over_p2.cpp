@@ -1,83 +1,50 @@
 #include <iostream>
-#include <fstream>
-#include <vector>
-#include <sstream>
-#include <regex>
+#include <cstring>
+#include <string>
 
-void process_matches(const std::string &substring, int &total_sum)
+#include "../common/command-line.hpp"
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+#include "mul-scanner.hpp"
+
+int main(int argc, char *argv[])
 {
-    std::regex pattern(R"(mul\((\d{1,3}),(\d{1,3})\))");
-    std::smatch match;
-    auto begin = std::sregex_iterator(substring.begin(), substring.end(), pattern);
-    auto end = std::sregex_iterator();
-    for (std::sregex_iterator i = begin; i != end; ++i)
+    std::string filename = "input_data";
+    size_t numberOfThreads = 0; // one per core, for inputs big enough to be worth splitting
+    for (int i = 1; i < argc; ++i)
     {
-        match = *i;
-        int num1 = std::stoi(match[1].str());
-        int num2 = std::stoi(match[2].str());
-        total_sum += num1 * num2;
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc && command_line::parseCount(argv[i + 1], numberOfThreads) && numberOfThreads > 0)
+        {
+            ++i;
+        }
+        else if (i == 1 && argv[i][0] != '-')
+        {
+            filename = argv[i];
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [input_data] [--threads N]" << std::endl;
+            return 1;
+        }
     }
-}
 
-int main()
-{
-    std::ifstream file("input_data");
+    InputView input(filename);
 
-    if (!file.is_open())
+    if (!input.isOpen())
     {
         std::cerr << "Unable to open file" << std::endl;
         return 1;
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string data = buffer.str();
-
-    file.close();
+    std::string_view data = input.data();
 
-    std::cout << "Memory data:" << data << std::endl;
+    LOG_DEBUG("Memory data:", data);
 
-    int total_sum = 0;
-    size_t pos = 0;
-    bool process = true;
+    // "do()" and "don't()" are recognized in the same pass as "mul(a,b)"; chunks are scanned
+    // without knowing the state at their start and stitched together afterwards
+    ChunkSummary summary = scanParallel(data, numberOfThreads);
 
-    while (pos < data.size())
-    {
-        size_t dont_pos = data.find("don't()", pos);
-        size_t do_pos = data.find("do()", pos);
-
-        if (dont_pos != std::string::npos && (do_pos == std::string::npos || dont_pos < do_pos))
-        {
-            if (process)
-            { // process the data before the first "don't()" substring
-                process_matches(data.substr(pos, dont_pos - pos), total_sum);
-            }
-            process = false;
-            pos = dont_pos + 7; // move past "don't()"
-        }
-        else if (do_pos != std::string::npos)
-        {
-            if (!process)
-            {
-                process = true;
-                pos = do_pos + 4; // move past "do()"
-            }
-            else
-            {
-                process_matches(data.substr(pos, do_pos - pos), total_sum);
-                pos = do_pos + 4; // move past "do()"
-            }
-        }
-        else
-        {
-            if (process)
-            {
-                process_matches(data.substr(pos), total_sum);
-            }
-            break;
-        }
-    }
-    std::cout << "The total sum of all multiplications is: " << total_sum << std::endl;
+    results() << "The total sum of all multiplications is: " << summary.sumIfStartEnabled << '\n';
 
     return 0;
-}
\ No newline at end of file
+}
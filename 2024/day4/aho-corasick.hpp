@@ -0,0 +1,173 @@
+#ifndef AOC_2024_DAY4_AHO_CORASICK_HPP
+#define AOC_2024_DAY4_AHO_CORASICK_HPP
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Aho-Corasick automaton that counts how often each word of a dictionary occurs in a text.
+ *
+ * The automaton is a trie of the words completed into a full transition table, so feeding a
+ * character is a single table lookup and every text is scanned once no matter how many words
+ * there are. Characters are first mapped to a compact alphabet made of the letters used by the
+ * words, plus one symbol for everything else, which keeps the table small.
+ *
+ * Counting works in two steps. While scanning, only the state reached after each character is
+ * tallied. counts() then pushes the tallies along the failure links (every state also ends all
+ * words that end in its failure state), which gives the number of occurrences of each word.
+ *
+ * @code
+ * AhoCorasick automaton({"XMAS", "MAS"});
+ * automaton.scan("XMASAMX");
+ * std::vector<size_t> counts = automaton.counts(); // {1, 1}
+ * @endcode
+ */
+class AhoCorasick
+{
+public:
+    /**
+     * @brief Starting state, used at the beginning of every text.
+     */
+    static constexpr int ROOT = 0;
+
+    explicit AhoCorasick(const std::vector<std::string> &words)
+    {
+        symbolOf_.fill(0);
+        for (const std::string &word : words)
+        {
+            for (char letter : word)
+            {
+                uint8_t &symbol = symbolOf_[static_cast<unsigned char>(letter)];
+                if (symbol == 0)
+                {
+                    symbol = static_cast<uint8_t>(++alphabetSize_);
+                }
+            }
+        }
+        alphabetSize_++; // symbol 0 stands for every character not in any word
+
+        addState();
+        for (const std::string &word : words)
+        {
+            int state = 0;
+            for (char letter : word)
+            {
+                size_t edge = static_cast<size_t>(state) * alphabetSize_ + symbolOf_[static_cast<unsigned char>(letter)];
+                if (transitions_[edge] == ROOT)
+                {
+                    int next = addState(); // grows transitions_, so no reference into it is held here
+                    transitions_[edge] = next;
+                }
+                state = transitions_[edge];
+            }
+            wordStates_.push_back(state);
+        }
+        build();
+        hits_.assign(fail_.size(), 0);
+    }
+
+    /**
+     * @brief Feeds one character and tallies the state it leads to.
+     *
+     * @return The new state.
+     */
+    int step(int state, char c)
+    {
+        state = transitions_[state * alphabetSize_ + symbolOf_[static_cast<unsigned char>(c)]];
+        hits_[state]++;
+        return state;
+    }
+
+    /**
+     * @brief Scans one text from the starting state.
+     */
+    void scan(std::string_view text)
+    {
+        int state = ROOT;
+        for (char c : text)
+        {
+            state = step(state, c);
+        }
+    }
+
+    /**
+     * @brief Number of occurrences of each word, in the order the words were given, over all texts scanned so far.
+     */
+    std::vector<size_t> counts() const
+    {
+        std::vector<size_t> total = hits_;
+        // deeper states come later in BFS order, so walking it backwards finishes a state before its failure state
+        for (auto it = bfsOrder_.rbegin(); it != bfsOrder_.rend(); ++it)
+        {
+            total[fail_[*it]] += total[*it];
+        }
+
+        std::vector<size_t> result;
+        result.reserve(wordStates_.size());
+        for (int state : wordStates_)
+        {
+            result.push_back(state == ROOT ? 0 : total[state]);
+        }
+        return result;
+    }
+
+private:
+    int addState()
+    {
+        transitions_.resize(transitions_.size() + alphabetSize_, 0);
+        fail_.push_back(ROOT);
+        return static_cast<int>(fail_.size()) - 1;
+    }
+
+    /**
+     * @brief Computes the failure links and fills in the missing transitions, breadth first.
+     */
+    void build()
+    {
+        std::deque<int> queue;
+        for (int symbol = 0; symbol < alphabetSize_; ++symbol)
+        {
+            int next = transitions_[ROOT * alphabetSize_ + symbol];
+            if (next != ROOT)
+            {
+                queue.push_back(next);
+            }
+        }
+
+        while (!queue.empty())
+        {
+            int state = queue.front();
+            queue.pop_front();
+            bfsOrder_.push_back(state);
+
+            for (int symbol = 0; symbol < alphabetSize_; ++symbol)
+            {
+                int &next = transitions_[state * alphabetSize_ + symbol];
+                int fallback = transitions_[fail_[state] * alphabetSize_ + symbol];
+                if (next == ROOT)
+                {
+                    next = fallback;
+                }
+                else
+                {
+                    fail_[next] = fallback;
+                    queue.push_back(next);
+                }
+            }
+        }
+    }
+
+    std::array<uint8_t, 256> symbolOf_;
+    int alphabetSize_ = 0;
+    std::vector<int> transitions_; // alphabetSize_ entries per state
+    std::vector<int> fail_;
+    std::vector<int> bfsOrder_; // every state except the root
+    std::vector<int> wordStates_;
+    std::vector<size_t> hits_;
+};
+
+#endif // AOC_2024_DAY4_AHO_CORASICK_HPP
@@ -1,170 +1,141 @@
 #include <iostream>
-#include <fstream>
 #include <vector>
 #include <string>
 #include <tuple>
+#include <cstring>
 
-/**
- * @brief Directions for searching in the grid.
- *
- * The directions are represented as pairs of integers, where each pair
- * corresponds to a direction: right, down, down-right diagonal, down-left diagonal,
- * left, up, up-left diagonal, and up-right diagonal.
- * Right (0, 1), Down (1, 0), Down-right diagonal (1, 1), Down-left diagonal (1, -1),
- * Left (0, -1), Up (-1, 0), Up-left diagonal (-1, -1), Up-right diagonal (-1, 1)
- */
-std::vector<std::pair<int, int>> directions = {
-    {0, 1}, {1, 0}, {1, 1}, {1, -1}, {0, -1}, {-1, 0}, {-1, -1}, {-1, 1}};
+#include "../common/command-line.hpp"
+#include "../common/grid.hpp"
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+#include "stencil-matcher.hpp"
+#include "xmas-search.hpp"
 
 /**
- * @brief Searches for the substring starting from a given position in a specific direction.
- *
- * @param grid The 2D grid of characters.
- * @param word The substring to search for.
- * @param x The starting row index.
- * @param y The starting column index.
- * @param dx The row direction increment.
- * @param dy The column direction increment.
- * @return true if the substring is found in the specified direction, false otherwise.
+ * @brief Splits a comma separated list of words.
  */
-bool search_in_specified_direction(const std::vector<std::vector<char>> &grid, const std::string &word, int x, int y, int dx, int dy)
+std::vector<std::string> split_words(std::string_view list)
 {
-    int rows = grid.size();
-    int cols = grid[0].size();
-    int word_len = word.length();
-
-    for (int i = 0; i < word_len; ++i)
+    std::vector<std::string> words;
+    std::string_view word;
+    while (nextField(list, word, ','))
     {
-        int nx = x + i * dx;
-        int ny = y + i * dy;
-        if (nx < 0 || ny < 0 || nx >= rows || ny >= cols || grid[nx][ny] != word[i])
-        {
-            return false;
-        }
+        words.emplace_back(word);
     }
-    return true;
+    return words;
 }
 
 /**
- * @brief Finds all occurrences of a substring in a 2D grid of characters.
+ * @brief The main function.
  *
- * The function searches for the substring in all eight possible directions
- * (horizontal, vertical, diagonal, and their reverse orders).
+ * Initializes the grid and the substring to search for, counts the occurrences of the substring
+ * and of its X shape on bitplanes, and prints the results. With `--list` every occurrence is
+ * printed as well. `--words` counts a whole comma separated word list instead, and `--pattern`
+ * counts a 2D shape ('.' is a wildcard) in all its rotations and reflections. `--threads` sets the
+ * number of row tiles counted in parallel.
  *
- * @param grid The 2D grid of characters.
- * @param word The substring to search for.
- * @return A vector of tuples, each containing the starting row index, starting column index,
- *         row direction increment, and column direction increment for each occurrence of the substring.
+ * @return int Exit status.
  */
-std::vector<std::tuple<int, int, int, int>> find_substring(const std::vector<std::vector<char>> &grid, const std::string &word)
-{
-    int rows = grid.size();
-    int cols = grid[0].size();
-    std::vector<std::tuple<int, int, int, int>> occurrences;
-
-    for (int r = 0; r < rows; ++r)
+int main(int argc, char *argv[]) {
+    size_t numberOfThreads = 0; // one per core, for grids big enough to be worth splitting
+    std::string mode;           // --list, --words or --pattern
+    const char *modeArgument = nullptr;
+    bool validArguments = argc >= 2;
+    for (int i = 2; i < argc && validArguments; ++i)
     {
-        for (int c = 0; c < cols; ++c)
+        if (std::strcmp(argv[i], "--threads") == 0)
         {
-            for (auto [dx, dy] : directions)
-            {
-                if (search_in_specified_direction(grid, word, r, c, dx, dy))
-                {
-                    occurrences.emplace_back(r, c, dx, dy);
-                }
-            }
+            validArguments = i + 1 < argc && command_line::parseCount(argv[++i], numberOfThreads) && numberOfThreads > 0;
         }
-    }
-    return occurrences;
-}
-
-/**
- * @brief Finds the positions of the character 'A' which is the center of an "X" shaped substring "MAS" in a 2D grid.
- *
- * This function scans a 2D grid to find all positions where the character 'A' is surrounded diagonally by the characters
- * 'M' and 'S' in any of the four possible "X" shaped patterns.
- *
- * @param grid A 2D vector of characters representing the grid.
- * @return A vector of pairs, where each pair contains the row and column indices of the center 'A' of an "X" shaped substring "MAS".
- */
-std::vector<std::pair<int, int>> find_x_shape_centers(const std::vector<std::vector<char>> &grid)
-{
-    std::vector<std::pair<int, int>> centers;
-    int rows = grid.size();
-    int cols = grid[0].size();
-
-    for (int i = 1; i < rows - 1; ++i)
-    {
-        for (int j = 1; j < cols - 1; ++j)
+        else if (mode.empty() && std::strcmp(argv[i], "--list") == 0)
         {
-            if (grid[i][j] == 'A' &&
-                ((grid[i - 1][j - 1] == 'M' && grid[i - 1][j + 1] == 'M' && grid[i + 1][j - 1] == 'S' && grid[i + 1][j + 1] == 'S') ||
-                 (grid[i - 1][j - 1] == 'M' && grid[i - 1][j + 1] == 'S' && grid[i + 1][j - 1] == 'M' && grid[i + 1][j + 1] == 'S') ||
-                 (grid[i - 1][j - 1] == 'S' && grid[i - 1][j + 1] == 'S' && grid[i + 1][j - 1] == 'M' && grid[i + 1][j + 1] == 'M') ||
-                 (grid[i - 1][j - 1] == 'S' && grid[i - 1][j + 1] == 'M' && grid[i + 1][j - 1] == 'S' && grid[i + 1][j + 1] == 'M')))
-            {
-                centers.push_back({i, j});
-            }
+            mode = argv[i];
+        }
+        else if (mode.empty() && (std::strcmp(argv[i], "--words") == 0 || std::strcmp(argv[i], "--pattern") == 0))
+        {
+            mode = argv[i];
+            validArguments = i + 1 < argc && argv[i + 1][0] != '\0' && std::strcmp(argv[i + 1], "--threads") != 0;
+            modeArgument = argv[++i];
+        }
+        else
+        {
+            validArguments = false;
         }
     }
-
-    return centers;
-}
-/**
- * @brief The main function.
- *
- * Initializes the grid and the substring to search for, calls the find_substring function,
- * and prints the results.
- *
- * @return int Exit status.
- */
-int main(int argc, char *argv[]) {
-    if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <input_data>" << std::endl;
+    if (!validArguments) {
+        std::cerr << "Usage: " << argv[0] << " <input_data> [--threads N] [--list | --words w1,w2,... | --pattern row1/row2/...]\n";
         return 1;
     }
 
     std::string filename = argv[1];
 
-    std::ifstream file(filename);
-    std::vector<std::vector<char>> grid;
-    std::string line;
+    InputView input(filename);
     std::string word = "XMAS";
-    int xmasCounter = 0;
-    int xShapedMassCounter = 0;
+    size_t xmasCounter = 0;
+    size_t xShapedMassCounter = 0;
 
-    if (!file.is_open())
+    if (!input.isOpen())
     {
         std::cerr << "ERROR: Could not open the file";
         return 1;
     }
 
-    while (std::getline(file, line))
+    StencilMatcher xShape(X_MAS_PATTERN, Symmetry::ALL);
+    auto count = [&](const auto &grid)
     {
-        std::vector<char> row(line.begin(), line.end());
-        grid.push_back(row);
-    }
-
-    file.close();
+        return count_tiled(grid, word, xShape, numberOfThreads);
+    };
 
-    auto occurrences = find_substring(grid, word);
-    for (const auto &[r, c, dx, dy] : occurrences)
+    if (mode == "--pattern")
     {
-        // std::cout << "Found at (" << r << ", " << c << ") in direction (" << dx << ", " << dy << ")\n";
-        xmasCounter++;
+        std::vector<std::string> pattern;
+        std::string_view rows = modeArgument, row;
+        while (nextField(rows, row, '/'))
+        {
+            pattern.emplace_back(row);
+        }
+        StencilMatcher matcher(pattern, Symmetry::ALL);
+        auto countPattern = [&](const auto &grid) { return matcher.count(Bitplanes(grid, matcher.letters())); };
+        size_t placements = dispatchGrid<char, BORDER, InputShape>(input, SENTINEL, keepCharacter, countPattern);
+        results() << "Pattern " << modeArgument << " (" << matcher.variants() << " variants) appeared " << placements << " times.\n";
+        return 0;
     }
 
-    std::cout << word << " appeared " << xmasCounter << " times." << std::endl;
-
-    auto positions = find_x_shape_centers(grid);
+    if (mode == "--words")
+    {
+        std::vector<std::string> words = split_words(modeArgument);
+        auto countAll = [&](const auto &grid) { return count_words(grid, words); };
+        std::vector<size_t> counts = dispatchGrid<char, BORDER, InputShape>(input, SENTINEL, keepCharacter, countAll);
+        for (size_t i = 0; i < words.size(); ++i)
+        {
+            results() << words[i] << " appeared " << counts[i] << " times.\n";
+        }
+        return 0;
+    }
 
-    for (const auto &pos : positions)
+    if (mode == "--list")
+    {
+        auto list = [&](const auto &grid)
+        {
+            for (const auto &[r, c, dx, dy] : find_substring(grid, word))
+            {
+                results() << "Found at (" << r << ", " << c << ") in direction (" << dx << ", " << dy << ")\n";
+            }
+            for (const auto &[r, c] : find_x_shape_centers(grid))
+            {
+                results() << "Center of X shape found at: (" << r << ", " << c << ")\n";
+            }
+            return count(grid);
+        };
+        std::tie(xmasCounter, xShapedMassCounter) = dispatchGrid<char, BORDER, InputShape>(input, SENTINEL, keepCharacter, list);
+    }
+    else
     {
-        // std::cout << "Center of X shape found at: (" << pos.first << ", " << pos.second << ")" << std::endl;
-        xShapedMassCounter++;
+        std::tie(xmasCounter, xShapedMassCounter) = dispatchGrid<char, BORDER, InputShape>(input, SENTINEL, keepCharacter, count);
     }
 
-    std::cout << "X shaped " << word << " appeared " << xShapedMassCounter << " times." << std::endl;
+    results() << word << " appeared " << xmasCounter << " times.\n";
+    results() << "X shaped " << word << " appeared " << xShapedMassCounter << " times.\n";
 
     return 0;
-}
\ No newline at end of file
+}
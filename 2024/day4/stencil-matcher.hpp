@@ -0,0 +1,204 @@
+#ifndef AOC_2024_DAY4_STENCIL_MATCHER_HPP
+#define AOC_2024_DAY4_STENCIL_MATCHER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "word-bitboard.hpp"
+
+/**
+ * @brief Which transformed copies of a pattern are searched for as well.
+ */
+enum class Symmetry
+{
+    NONE,      ///< the pattern as written
+    ROTATIONS, ///< the pattern turned by 0, 90, 180 and 270 degrees
+    ALL        ///< the rotations plus their mirror images
+};
+
+/**
+ * @brief Counts the placements of a small 2D pattern with wildcards on bitplanes.
+ *
+ * A pattern is given as rows of equal length where '.' matches any cell and every other character
+ * must match exactly, e.g. the X-MAS shape is {"M.S", ".A.", "M.S"}. The pattern is compiled into
+ * one program per distinct variant (rotation/reflection). A program is the list of its fixed cells,
+ * each as (row offset, column offset, letter) from the top-left corner of the variant. Variants
+ * that end up with the same cells, as happens for symmetric patterns, are only kept once, so every
+ * placement of the shape is counted exactly once.
+ *
+ * Running a program on 64 anchor cells at once is an AND over its cells of the plane row of the
+ * letter, taken from the row below by the row offset and shifted by the column offset. All programs
+ * run in the same pass over the rows.
+ *
+ * Patterns can be at most 64 columns wide.
+ */
+class StencilMatcher
+{
+public:
+    /**
+     * @brief Character that matches any cell.
+     */
+    static constexpr char WILDCARD = '.';
+
+    /**
+     * @brief One fixed cell of a variant.
+     */
+    struct Term
+    {
+        int dRow;
+        int dCol;
+        char letter;
+
+        bool operator<(const Term &other) const
+        {
+            return std::tie(dRow, dCol, letter) < std::tie(other.dRow, other.dCol, other.letter);
+        }
+    };
+
+    /**
+     * @brief Compiles the pattern and its variants.
+     *
+     * @param pattern The rows of the pattern; '.' is a wildcard.
+     * @param symmetry Which variants to search for.
+     */
+    StencilMatcher(const std::vector<std::string> &pattern, Symmetry symmetry)
+    {
+        std::vector<Term> terms;
+        for (size_t r = 0; r < pattern.size(); ++r)
+        {
+            for (size_t c = 0; c < pattern[r].size(); ++c)
+            {
+                if (pattern[r][c] != WILDCARD)
+                {
+                    terms.push_back({static_cast<int>(r), static_cast<int>(c), pattern[r][c]});
+                    if (letters_.find(pattern[r][c]) == std::string::npos)
+                    {
+                        letters_ += pattern[r][c];
+                    }
+                }
+            }
+        }
+        if (terms.empty())
+        {
+            return;
+        }
+
+        int rotations = symmetry == Symmetry::NONE ? 1 : 4;
+        int reflections = symmetry == Symmetry::ALL ? 2 : 1;
+        std::set<std::vector<Term>> seen;
+        for (int reflection = 0; reflection < reflections; ++reflection)
+        {
+            std::vector<Term> variant = terms;
+            if (reflection == 1)
+            {
+                for (Term &term : variant)
+                {
+                    term.dCol = -term.dCol;
+                }
+            }
+            for (int rotation = 0; rotation < rotations; ++rotation)
+            {
+                normalize(variant);
+                if (seen.insert(variant).second)
+                {
+                    programs_.push_back(variant);
+                }
+                for (Term &term : variant)
+                {
+                    // a quarter turn clockwise: (r, c) -> (c, -r)
+                    term = {term.dCol, -term.dRow, term.letter};
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief The letters the pattern uses; the bitplanes passed to count() need all of them.
+     */
+    const std::string &letters() const { return letters_; }
+
+    /**
+     * @brief Number of distinct variants that are searched for.
+     */
+    size_t variants() const { return programs_.size(); }
+
+    /**
+     * @brief Number of rows below its top row that a placement reaches, over all variants.
+     */
+    int reach() const
+    {
+        int reach = 0;
+        for (const std::vector<Term> &program : programs_)
+        {
+            reach = std::max(reach, program.back().dRow);
+        }
+        return reach;
+    }
+
+    /**
+     * @brief Counts the placements of all variants.
+     *
+     * @param planes Bitplanes holding at least the letters().
+     * @param anchorRows Only placements whose top row is one of the first `anchorRows` rows are counted; -1 for all rows.
+     */
+    size_t count(const Bitplanes &planes, int anchorRows = -1) const
+    {
+        size_t count = 0;
+        std::vector<const uint64_t *> rows;
+        int endRow = anchorRows < 0 ? planes.rows() : std::min(anchorRows, planes.rows());
+        for (int r = 0; r < endRow; ++r)
+        {
+            for (const std::vector<Term> &program : programs_)
+            {
+                if (r + program.back().dRow >= planes.rows())
+                {
+                    continue; // the terms are sorted, so the last one is in the lowest row
+                }
+                rows.clear();
+                for (const Term &term : program)
+                {
+                    rows.push_back(planes.row(term.letter, r + term.dRow));
+                }
+                for (size_t w = 0; w < planes.wordsPerRow(); ++w)
+                {
+                    uint64_t match = ~uint64_t(0);
+                    for (size_t i = 0; i < program.size(); ++i)
+                    {
+                        match &= bitboard::shiftedWord(rows[i], w, program[i].dCol);
+                    }
+                    count += __builtin_popcountll(match);
+                }
+            }
+        }
+        return count;
+    }
+
+private:
+    /**
+     * @brief Moves the variant so its bounding box starts at (0, 0) and sorts its terms.
+     */
+    static void normalize(std::vector<Term> &variant)
+    {
+        int minRow = variant[0].dRow, minCol = variant[0].dCol;
+        for (const Term &term : variant)
+        {
+            minRow = std::min(minRow, term.dRow);
+            minCol = std::min(minCol, term.dCol);
+        }
+        for (Term &term : variant)
+        {
+            term.dRow -= minRow;
+            term.dCol -= minCol;
+        }
+        std::sort(variant.begin(), variant.end());
+    }
+
+    std::string letters_;
+    std::vector<std::vector<Term>> programs_;
+};
+
+#endif // AOC_2024_DAY4_STENCIL_MATCHER_HPP
@@ -0,0 +1,180 @@
+#ifndef AOC_2024_DAY4_WORD_BITBOARD_HPP
+#define AOC_2024_DAY4_WORD_BITBOARD_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief One bit per grid cell for each of a few letters.
+ *
+ * Row r of the plane for a letter is a run of 64-bit words where bit c (bit c % 64 of word c / 64)
+ * is set if the cell (r, c) holds that letter. Every row is padded with a zero word on both sides,
+ * so reading the neighbors of any word of the row never needs a bounds check, and the bits past
+ * the last column are zero as well.
+ *
+ * Checking one letter of a pattern for 64 cells at once is then a single AND with a plane row that
+ * is shifted by the column offset of that letter, see shiftedWord().
+ */
+class Bitplanes
+{
+public:
+    /**
+     * @brief Builds the planes of the given letters from a grid, or from a band of its rows.
+     *
+     * @param grid Any grid with rows(), cols() and operator()(row, col).
+     * @param letters The letters to build planes for; repeated letters are ignored.
+     * @param firstRow The grid row that becomes row 0 of the planes.
+     * @param numberOfRows How many grid rows to take; -1 (or too many) takes all rows up to the end.
+     */
+    template <typename GridT>
+    Bitplanes(const GridT &grid, std::string_view letters, int firstRow = 0, int numberOfRows = -1)
+        : rows_(numberOfRows < 0 || firstRow + numberOfRows > grid.rows() ? grid.rows() - firstRow : numberOfRows),
+          cols_(grid.cols()), wordsPerRow_((grid.cols() + 63) / 64), stride_(wordsPerRow_ + 2)
+    {
+        planeOf_.fill(-1);
+        for (char letter : letters)
+        {
+            if (planeOf_[static_cast<unsigned char>(letter)] < 0)
+            {
+                planeOf_[static_cast<unsigned char>(letter)] = numberOfPlanes_++;
+            }
+        }
+        bits_.assign(static_cast<size_t>(numberOfPlanes_ + 1) * rows_ * stride_, 0);
+
+        for (int r = 0; r < rows_; ++r)
+        {
+            for (int c = 0; c < cols_; ++c)
+            {
+                int plane = planeOf_[static_cast<unsigned char>(grid(firstRow + r, c))];
+                if (plane >= 0)
+                {
+                    bits_[offsetOf(plane, r) + 1 + c / 64] |= uint64_t(1) << (c % 64);
+                }
+            }
+        }
+    }
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    size_t wordsPerRow() const { return wordsPerRow_; }
+
+    /**
+     * @brief First word of row r of the plane for `letter`.
+     *
+     * The word before it and the word after the last one are zero. Letters without a plane
+     * get an all-zero row.
+     */
+    const uint64_t *row(char letter, int r) const
+    {
+        int plane = planeOf_[static_cast<unsigned char>(letter)];
+        return &bits_[offsetOf(plane < 0 ? numberOfPlanes_ : plane, r) + 1];
+    }
+
+private:
+    size_t offsetOf(int plane, int r) const { return (static_cast<size_t>(plane) * rows_ + r) * stride_; }
+
+    int rows_;
+    int cols_;
+    size_t wordsPerRow_;
+    size_t stride_;
+    int numberOfPlanes_ = 0;
+    std::array<int, 256> planeOf_;
+    std::vector<uint64_t> bits_; // one extra all-zero plane at the end for letters without a plane
+};
+
+namespace bitboard
+{
+    /**
+     * @brief Word w of a plane row, shifted so that bit c holds the cell at column c + shift.
+     *
+     * @param row A plane row as returned by Bitplanes::row().
+     * @param w The word index.
+     * @param shift Column offset, -63 to 63.
+     */
+    inline uint64_t shiftedWord(const uint64_t *row, size_t w, int shift)
+    {
+        if (shift > 0)
+        {
+            return (row[w] >> shift) | (row[w + 1] << (64 - shift));
+        }
+        if (shift < 0)
+        {
+            return (row[w] << -shift) | (row[w - 1] >> (64 + shift));
+        }
+        return row[w];
+    }
+
+    /**
+     * @brief Counts the cells where `word` starts and reads along (dRow, dCol).
+     *
+     * For every block of 64 cells the letters are ANDed in: letter i comes from the row i * dRow
+     * further down, shifted by i * dCol columns.
+     *
+     * @param dRow 0 or 1.
+     * @param dCol -1, 0 or 1.
+     * @param anchorRows Only matches starting in the first `anchorRows` rows are counted; -1 for all rows.
+     */
+    inline size_t countInDirection(const Bitplanes &planes, std::string_view word, int dRow, int dCol, int anchorRows = -1)
+    {
+        int lastRow = planes.rows() - 1 - static_cast<int>(word.size() - 1) * dRow;
+        if (anchorRows >= 0)
+        {
+            lastRow = std::min(lastRow, anchorRows - 1);
+        }
+        size_t count = 0;
+        std::vector<const uint64_t *> rows(word.size());
+        for (int r = 0; r <= lastRow; ++r)
+        {
+            for (size_t i = 0; i < word.size(); ++i)
+            {
+                rows[i] = planes.row(word[i], r + static_cast<int>(i) * dRow);
+            }
+            for (size_t w = 0; w < planes.wordsPerRow(); ++w)
+            {
+                uint64_t match = rows[0][w];
+                for (size_t i = 1; i < word.size(); ++i)
+                {
+                    match &= shiftedWord(rows[i], w, static_cast<int>(i) * dCol);
+                }
+                count += __builtin_popcountll(match);
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Counts the occurrences of `word` in all eight directions.
+     *
+     * The four backward directions are the forward ones with the word reversed, so only right,
+     * down, down-right and down-left are scanned, once for the word and once for its reverse.
+     * The word can have at most 64 letters.
+     *
+     * @param planes Bitplanes holding at least the letters of the word.
+     * @param word The word to search for.
+     * @param anchorRows Only matches starting in the first `anchorRows` rows are counted; -1 for all rows.
+     */
+    inline size_t countWord(const Bitplanes &planes, std::string_view word, int anchorRows = -1)
+    {
+        if (word.empty())
+        {
+            return 0;
+        }
+        std::string reversed(word.rbegin(), word.rend());
+        constexpr std::array<std::pair<int, int>, 4> forward = {{{0, 1}, {1, 0}, {1, 1}, {1, -1}}};
+
+        size_t count = 0;
+        for (auto [dRow, dCol] : forward)
+        {
+            count += countInDirection(planes, word, dRow, dCol, anchorRows);
+            count += countInDirection(planes, reversed, dRow, dCol, anchorRows);
+        }
+        return count;
+    }
+}
+
+#endif // AOC_2024_DAY4_WORD_BITBOARD_HPP
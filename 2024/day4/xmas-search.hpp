@@ -0,0 +1,307 @@
+#ifndef AOC_2024_DAY4_XMAS_SEARCH_HPP
+#define AOC_2024_DAY4_XMAS_SEARCH_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../common/grid.hpp"
+#include "aho-corasick.hpp"
+#include "stencil-matcher.hpp"
+#include "word-bitboard.hpp"
+
+/**
+ * @brief Directions for searching in the grid.
+ *
+ * The directions are represented as pairs of integers, where each pair
+ * corresponds to a direction: right, down, down-right diagonal, down-left diagonal,
+ * left, up, up-left diagonal, and up-right diagonal.
+ * Right (0, 1), Down (1, 0), Down-right diagonal (1, 1), Down-left diagonal (1, -1),
+ * Left (0, -1), Up (-1, 0), Up-left diagonal (-1, -1), Up-right diagonal (-1, 1)
+ */
+inline std::vector<std::pair<int, int>> directions = {
+    {0, 1}, {1, 0}, {1, 1}, {1, -1}, {0, -1}, {-1, 0}, {-1, -1}, {-1, 1}};
+
+/**
+ * @brief The X-MAS shape: two "MAS" crossing on the 'A'; its rotations and reflections cover both reading directions.
+ */
+const std::vector<std::string> X_MAS_PATTERN = {"M.S", ".A.", "M.S"};
+
+/**
+ * @brief Value of the grid border; it never matches a letter of the word.
+ */
+constexpr char SENTINEL = '\0';
+
+/**
+ * @brief Width of the grid border: a search for "XMAS" walks at most 3 cells away from its start.
+ */
+constexpr int BORDER = 3;
+
+/**
+ * @brief Size of the puzzle input, which gets a fixed-size grid.
+ */
+using InputShape = GridShape<140, 140>;
+
+/**
+ * @brief Searches for the substring starting from a given cell in a specific direction.
+ *
+ * The grid border must be at least `word.length() - 1` cells wide, so the walk
+ * never leaves the buffer and running off the map just fails to match the sentinel.
+ *
+ * @param grid The grid of characters.
+ * @param word The substring to search for.
+ * @param start The flat index of the starting cell.
+ * @param step The flat index offset of the direction.
+ * @return true if the substring is found in the specified direction, false otherwise.
+ */
+template <typename GridT>
+bool search_in_specified_direction(const GridT &grid, const std::string &word, size_t start, std::ptrdiff_t step)
+{
+    size_t cell = start;
+    for (char letter : word)
+    {
+        if (grid[cell] != letter)
+        {
+            return false;
+        }
+        cell += step;
+    }
+    return true;
+}
+
+/**
+ * @brief Calls `onMatch(row, col, dx, dy)` for every occurrence of a substring in a 2D grid of characters.
+ *
+ * The function searches for the substring in all eight possible directions
+ * (horizontal, vertical, diagonal, and their reverse orders).
+ *
+ * @param grid The grid of characters.
+ * @param word The substring to search for.
+ * @param onMatch Called with the starting row index, starting column index,
+ *        row direction increment, and column direction increment of each occurrence.
+ */
+template <typename GridT, typename OnMatch>
+void for_each_substring(const GridT &grid, const std::string &word, OnMatch onMatch)
+{
+    std::array<std::ptrdiff_t, 8> steps;
+    for (size_t d = 0; d < directions.size(); ++d)
+    {
+        steps[d] = grid.offset(directions[d].first, directions[d].second);
+    }
+
+    for (int r = 0; r < grid.rows(); ++r)
+    {
+        size_t cell = grid.index(r, 0);
+        for (int c = 0; c < grid.cols(); ++c, ++cell)
+        {
+            if (grid[cell] != word[0])
+            {
+                continue;
+            }
+            for (size_t d = 0; d < directions.size(); ++d)
+            {
+                if (search_in_specified_direction(grid, word, cell, steps[d]))
+                {
+                    onMatch(r, c, directions[d].first, directions[d].second);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Finds all occurrences of a substring in a 2D grid of characters.
+ *
+ * @param grid The grid of characters.
+ * @param word The substring to search for.
+ * @return A vector of tuples, each containing the starting row index, starting column index,
+ *         row direction increment, and column direction increment for each occurrence of the substring.
+ */
+template <typename GridT>
+std::vector<std::tuple<int, int, int, int>> find_substring(const GridT &grid, const std::string &word)
+{
+    std::vector<std::tuple<int, int, int, int>> occurrences;
+    for_each_substring(grid, word, [&](int r, int c, int dx, int dy)
+                       { occurrences.emplace_back(r, c, dx, dy); });
+    return occurrences;
+}
+
+/**
+ * @brief Counts the occurrences of a substring in a 2D grid of characters without storing them.
+ *
+ * @param grid The grid of characters.
+ * @param word The substring to search for.
+ * @return The number of occurrences in all eight directions.
+ */
+template <typename GridT>
+size_t count_substring(const GridT &grid, const std::string &word)
+{
+    size_t count = 0;
+    for_each_substring(grid, word, [&](int, int, int, int)
+                       { count++; });
+    return count;
+}
+
+/**
+ * @brief Calls `onMatch(row, col)` for every character 'A' which is the center of an "X" shaped substring "MAS" in a 2D grid.
+ *
+ * A center is an 'A' surrounded diagonally by the characters 'M' and 'S' in any of the four possible
+ * "X" shaped patterns. Cells on the edge of the map see the sentinel border as their diagonal
+ * neighbors, so they are checked like every other cell.
+ *
+ * @param grid The grid of characters, with a border of at least one cell.
+ * @param onMatch Called with the row and column indices of each center.
+ */
+template <typename GridT, typename OnMatch>
+void for_each_x_shape_center(const GridT &grid, OnMatch onMatch)
+{
+    const std::ptrdiff_t upLeft = grid.offset(-1, -1);
+    const std::ptrdiff_t upRight = grid.offset(-1, 1);
+    const std::ptrdiff_t downLeft = grid.offset(1, -1);
+    const std::ptrdiff_t downRight = grid.offset(1, 1);
+
+    for (int i = 0; i < grid.rows(); ++i)
+    {
+        size_t cell = grid.index(i, 0);
+        for (int j = 0; j < grid.cols(); ++j, ++cell)
+        {
+            if (grid[cell] != 'A')
+            {
+                continue;
+            }
+            // each diagonal has to read "MAS" in one direction or the other
+            char a = grid[cell + upLeft], b = grid[cell + downRight];
+            char c = grid[cell + upRight], d = grid[cell + downLeft];
+            if (((a == 'M' && b == 'S') || (a == 'S' && b == 'M')) &&
+                ((c == 'M' && d == 'S') || (c == 'S' && d == 'M')))
+            {
+                onMatch(i, j);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Finds the positions of the character 'A' which is the center of an "X" shaped substring "MAS" in a 2D grid.
+ *
+ * @param grid The grid of characters, with a border of at least one cell.
+ * @return A vector of pairs, where each pair contains the row and column indices of the center 'A' of an "X" shaped substring "MAS".
+ */
+template <typename GridT>
+std::vector<std::pair<int, int>> find_x_shape_centers(const GridT &grid)
+{
+    std::vector<std::pair<int, int>> centers;
+    for_each_x_shape_center(grid, [&](int i, int j)
+                            { centers.push_back({i, j}); });
+    return centers;
+}
+
+/**
+ * @brief Counts the centers of "X" shaped substrings "MAS" in a 2D grid without storing them.
+ *
+ * @param grid The grid of characters, with a border of at least one cell.
+ * @return The number of centers.
+ */
+template <typename GridT>
+size_t count_x_shape_centers(const GridT &grid)
+{
+    size_t count = 0;
+    for_each_x_shape_center(grid, [&](int, int)
+                            { count++; });
+    return count;
+}
+
+/**
+ * @brief Counts the occurrences of every word of a list in all eight directions with one sweep of the grid.
+ *
+ * An Aho-Corasick automaton of the words is run over every line of the grid: each row, column and
+ * diagonal of both families, read in both directions. A line starts at every cell whose predecessor
+ * in the reading direction is the border and ends when the walk reaches the border again.
+ *
+ * @param grid The grid of characters, with a border of at least one cell.
+ * @param words The words to search for.
+ * @return The number of occurrences of each word, in the order of `words`.
+ */
+template <typename GridT>
+std::vector<size_t> count_words(const GridT &grid, const std::vector<std::string> &words)
+{
+    AhoCorasick automaton(words);
+
+    for (std::ptrdiff_t step : grid.neighborOffsets())
+    {
+        for (int r = 0; r < grid.rows(); ++r)
+        {
+            for (int c = 0; c < grid.cols(); ++c)
+            {
+                size_t cell = grid.index(r, c);
+                if (grid[cell - step] != SENTINEL)
+                {
+                    continue; // not the first cell of a line in this direction
+                }
+                int state = AhoCorasick::ROOT;
+                for (; grid[cell] != SENTINEL; cell += step)
+                {
+                    state = automaton.step(state, grid[cell]);
+                }
+            }
+        }
+    }
+    return automaton.counts();
+}
+
+/**
+ * @brief Counts the word and the X shape on bitplanes, splitting the grid into row tiles that are counted in parallel.
+ *
+ * Every tile builds its own bitplanes for its rows plus a halo of the rows below them that a match
+ * starting in the tile can reach (word length - 1 rows for the word, the pattern height - 1 for the
+ * X shape). Only matches starting in the tile's own rows are counted, so every match belongs to
+ * exactly one tile and the per-tile counts just add up.
+ *
+ * @param grid The grid of characters.
+ * @param word The word to search for.
+ * @param xShape The compiled X-MAS pattern.
+ * @param numberOfThreads Number of tiles/threads, at most one per core; 0 picks one per core, but keeps small grids on one thread.
+ * @return The number of occurrences of the word and of the X shape.
+ */
+template <typename GridT>
+std::pair<size_t, size_t> count_tiled(const GridT &grid, const std::string &word, const StencilMatcher &xShape, size_t numberOfThreads = 0)
+{
+    constexpr int MIN_TILE_ROWS = 2048;
+    size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    if (numberOfThreads == 0)
+    {
+        numberOfThreads = std::min<size_t>(cores, grid.rows() / MIN_TILE_ROWS + 1);
+    }
+    numberOfThreads = std::min(numberOfThreads, cores); // more threads than cores only add switching
+
+    const std::string letters = word + xShape.letters();
+    const int halo = std::max(static_cast<int>(word.size()) - 1, xShape.reach());
+    std::vector<std::pair<size_t, size_t>> counts(numberOfThreads);
+    std::vector<std::thread> workers;
+    int tileRows = grid.rows() / static_cast<int>(numberOfThreads) + 1;
+    for (size_t t = 0; t < numberOfThreads; ++t)
+    {
+        int firstRow = std::min(grid.rows(), static_cast<int>(t) * tileRows);
+        int rows = std::min(grid.rows() - firstRow, tileRows);
+        workers.emplace_back([&, t, firstRow, rows]()
+                             {
+            Bitplanes planes(grid, letters, firstRow, rows + halo);
+            counts[t] = {bitboard::countWord(planes, word, rows), xShape.count(planes, rows)}; });
+    }
+
+    std::pair<size_t, size_t> total = {0, 0};
+    for (size_t t = 0; t < numberOfThreads; ++t)
+    {
+        workers[t].join();
+        total.first += counts[t].first;
+        total.second += counts[t].second;
+    }
+    return total;
+}
+
+#endif // AOC_2024_DAY4_XMAS_SEARCH_HPP
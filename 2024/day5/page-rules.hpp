@@ -0,0 +1,196 @@
+#ifndef AOC_2024_DAY5_PAGE_RULES_HPP
+#define AOC_2024_DAY5_PAGE_RULES_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The ordering rules as a bit matrix over the page numbers.
+ *
+ * Bit (x, y) is set if a rule says page x must be printed before page y. The matrix has one row
+ * of 64-bit words per page number from 0 up to the largest page any rule mentions (100 x 100 bits
+ * for the usual two digit pages), so looking up a rule is one bit test instead of a hash lookup.
+ * Pages outside that range take part in no rule.
+ */
+class PageRules
+{
+public:
+    /**
+     * @brief Builds the matrix from the rules given as two columns: rule i is befores[i] | afters[i].
+     */
+    template <typename Number>
+    PageRules(const std::vector<Number> &befores, const std::vector<Number> &afters)
+    {
+        for (size_t i = 0; i < befores.size(); ++i)
+        {
+            pages_ = std::max({pages_, static_cast<int>(befores[i]) + 1, static_cast<int>(afters[i]) + 1});
+        }
+        wordsPerRow_ = (static_cast<size_t>(pages_) + 63) / 64;
+        bits_.assign(static_cast<size_t>(pages_) * wordsPerRow_, 0);
+        for (size_t i = 0; i < befores.size(); ++i)
+        {
+            int after = static_cast<int>(afters[i]);
+            bits_[static_cast<size_t>(befores[i]) * wordsPerRow_ + after / 64] |= uint64_t(1) << (after % 64);
+        }
+    }
+
+    /**
+     * @brief Number of page numbers the matrix covers, i.e. the largest page in a rule plus one.
+     */
+    int pages() const { return pages_; }
+
+    /**
+     * @brief Checks if a rule says page x must come before page y.
+     */
+    bool mustPrecede(int x, int y) const
+    {
+        if (x < 0 || y < 0 || x >= pages_ || y >= pages_)
+        {
+            return false;
+        }
+        return (bits_[static_cast<size_t>(x) * wordsPerRow_ + y / 64] >> (y % 64)) & 1;
+    }
+
+    /**
+     * @brief Checks if an update follows all rules that apply to it.
+     *
+     * Every pair of positions i < j is one bit test: the update is out of order as soon as the
+     * page at j must come before the page at i. That is k * (k - 1) / 2 tests for k pages,
+     * independent of the number of rules.
+     */
+    bool isOrdered(const int *update, size_t size) const
+    {
+        for (size_t j = 1; j < size; ++j)
+        {
+            for (size_t i = 0; i < j; ++i)
+            {
+                if (mustPrecede(update[j], update[i]))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool isOrdered(const std::vector<int> &update) const { return isOrdered(update.data(), update.size()); }
+
+    /**
+     * @brief Number of pages of the update that a rule puts before the page at `position`.
+     */
+    size_t predecessors(const int *update, size_t size, size_t position) const
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            count += mustPrecede(update[i], update[position]);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Middle page the update has once it is put in order, found without ordering it.
+     *
+     * The rules order the update completely exactly when no pair has rules in both directions and
+     * the predecessor counts within the update are a permutation of 0 .. k - 1. The page that ends
+     * up at position k / 2 is then the one with k / 2 predecessors. Checking that and finding it
+     * takes the same k * k bit tests as validation and leaves the update untouched.
+     *
+     * @param update The pages of the update.
+     * @param size Number of pages.
+     * @param seen Scratch space for the bit set of predecessor counts already seen.
+     * @return The middle page, or -1 if the rules leave some pair unordered or contradict each
+     *         other, so the order (and with it the middle page) depends on how ties are broken.
+     */
+    int orderedMiddle(const int *update, size_t size, std::vector<uint64_t> &seen) const
+    {
+        seen.assign((size + 63) / 64, 0);
+        int middle = -1;
+        for (size_t position = 0; position < size; ++position)
+        {
+            size_t count = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (mustPrecede(update[i], update[position]))
+                {
+                    if (mustPrecede(update[position], update[i]))
+                    {
+                        return -1; // rules in both directions
+                    }
+                    count++;
+                }
+            }
+            uint64_t bit = uint64_t(1) << (count % 64);
+            if (count >= size || (seen[count / 64] & bit))
+            {
+                return -1;
+            }
+            seen[count / 64] |= bit;
+            if (count == size / 2)
+            {
+                middle = update[position];
+            }
+        }
+        return middle;
+    }
+
+    /**
+     * @brief Puts the update in order with Kahn's algorithm.
+     *
+     * Pages whose predecessors are all placed are taken smallest page first, so pages the rules
+     * do not order come out in ascending order. If the rules form a cycle among the pages, the
+     * pages on it are appended in ascending order.
+     *
+     * @return false if the rules had a cycle among the pages of the update.
+     */
+    bool order(std::vector<int> &update) const
+    {
+        std::vector<size_t> waitingFor(update.size());
+        for (size_t i = 0; i < update.size(); ++i)
+        {
+            waitingFor[i] = predecessors(update.data(), update.size(), i);
+        }
+
+        std::vector<int> ordered;
+        ordered.reserve(update.size());
+        std::vector<bool> placed(update.size(), false);
+        bool acyclic = true;
+        while (ordered.size() < update.size())
+        {
+            size_t next = update.size();
+            for (size_t i = 0; i < update.size(); ++i)
+            {
+                if (!placed[i] && (next == update.size() || update[i] < update[next]) && (waitingFor[i] == 0 || !acyclic))
+                {
+                    next = i;
+                }
+            }
+            if (next == update.size())
+            {
+                acyclic = false; // nothing is ready, so the rest is held up by a cycle
+                continue;
+            }
+
+            placed[next] = true;
+            ordered.push_back(update[next]);
+            for (size_t i = 0; i < update.size(); ++i)
+            {
+                if (!placed[i] && mustPrecede(update[next], update[i]))
+                {
+                    waitingFor[i]--;
+                }
+            }
+        }
+        update = std::move(ordered);
+        return acyclic;
+    }
+
+private:
+    int pages_ = 0;
+    size_t wordsPerRow_ = 0;
+    std::vector<uint64_t> bits_;
+};
+
+#endif // AOC_2024_DAY5_PAGE_RULES_HPP
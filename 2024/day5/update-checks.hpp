@@ -0,0 +1,173 @@
+#ifndef AOC_2024_DAY5_UPDATE_CHECKS_HPP
+#define AOC_2024_DAY5_UPDATE_CHECKS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../common/number-parser.hpp"
+#include "page-ranking.hpp"
+#include "page-rules.hpp"
+
+/**
+ * @brief All updates, stored back to back: update u is pages[offsets[u]] .. pages[offsets[u + 1]].
+ */
+struct Updates {
+    std::vector<int> pages;
+    std::vector<size_t> offsets{0};
+
+    size_t size() const { return offsets.size() - 1; }
+};
+
+/**
+ * @brief Splits the input into the rule columns and the updates.
+ *
+ * Rules and updates are separated by the first empty line, which is "\r\n" in CRLF files.
+ *
+ * @param data The whole input.
+ * @param ruleColumns Receives the rules as two columns: rule i is ruleColumns[0][i] | ruleColumns[1][i].
+ * @param updates Receives the updates.
+ */
+inline void parseInput(std::string_view data, std::vector<std::vector<int64_t>> &ruleColumns, Updates &updates) {
+    size_t separatorPos = std::min(data.find("\n\n"), data.find("\n\r\n"));
+    std::string_view rulesPart = data.substr(0, separatorPos);
+    std::string_view updatesPart;
+    if (separatorPos != std::string_view::npos) {
+        updatesPart = data.substr(data.find('\n', separatorPos + 1) + 1);
+    }
+
+    ruleColumns.assign(2, {});
+    parseIntegerColumns(rulesPart, ruleColumns);
+
+    std::vector<int64_t> pages;
+    std::vector<size_t> updateOffsets;
+    parseIntegers(updatesPart, pages, &updateOffsets);
+    updates.pages.assign(pages.begin(), pages.end());
+    updates.offsets = std::move(updateOffsets);
+}
+
+/**
+ * @brief How to check and fix the updates.
+ */
+struct CheckOptions {
+    bool kahnMode = false;    ///< order invalid updates with Kahn's algorithm instead of picking the middle page
+    bool rankingMode = true;  ///< try the global ranking before the per-update path, if the rules are acyclic
+};
+
+/**
+ * @brief Counts and sums over a range of updates. Adding the sums of two ranges gives the sums of both.
+ */
+struct UpdateSums {
+    int64_t validUpdates = 0;
+    int64_t invalidUpdates = 0;
+    int64_t middlesOfValidUpdates = 0;
+    int64_t middlesOfFixedUpdates = 0;
+    int64_t rankedUpdates = 0;
+    int64_t perUpdateUpdates = 0;
+
+    UpdateSums &operator+=(const UpdateSums &other) {
+        validUpdates += other.validUpdates;
+        invalidUpdates += other.invalidUpdates;
+        middlesOfValidUpdates += other.middlesOfValidUpdates;
+        middlesOfFixedUpdates += other.middlesOfFixedUpdates;
+        rankedUpdates += other.rankedUpdates;
+        perUpdateUpdates += other.perUpdateUpdates;
+        return *this;
+    }
+};
+
+/**
+ * @brief Validates the updates first .. last - 1 and fixes the invalid ones.
+ *
+ * The updates themselves are not modified; updates that have to be reordered are copied into
+ * a scratch buffer first, so ranges can be checked on several threads at once.
+ */
+inline UpdateSums check_updates(const PageRules &rules, const PageRanking &ranking, const Updates &updates,
+                                size_t first, size_t last, const CheckOptions &options) {
+    UpdateSums sums;
+    std::vector<uint64_t> rankSet;
+    std::vector<uint64_t> seenCounts;
+    std::vector<int> fixed;
+    // the ranking of cyclic rules is not built
+    bool useRanking = options.rankingMode && ranking.isAcyclic();
+    for (size_t u = first; u < last; ++u) {
+        const int *update = &updates.pages[updates.offsets[u]];
+        size_t size = updates.offsets[u + 1] - updates.offsets[u];
+        if (size == 0) {
+            continue; // blank line, e.g. at the end of the file
+        }
+
+        if (useRanking && ranking.covers(update, size, rankSet)) {
+            sums.rankedUpdates++;
+            if (ranking.isOrdered(update, size)) {
+                sums.validUpdates++;
+                sums.middlesOfValidUpdates += update[size / 2];
+            }
+            else {
+                sums.invalidUpdates++;
+                fixed.resize(size);
+                ranking.order(fixed.data(), rankSet);
+                sums.middlesOfFixedUpdates += fixed[size / 2];
+            }
+            continue;
+        }
+
+        sums.perUpdateUpdates++;
+        if (rules.isOrdered(update, size)) {
+            sums.validUpdates++;
+            sums.middlesOfValidUpdates += update[size / 2];
+        }
+        else {
+            sums.invalidUpdates++;
+            int middle = options.kahnMode ? -1 : rules.orderedMiddle(update, size, seenCounts);
+            if (middle < 0) {
+                // either asked for, or the rules do not pin down the middle page: order the whole update
+                fixed.assign(update, update + size);
+                rules.order(fixed);
+                middle = fixed[size / 2];
+            }
+            sums.middlesOfFixedUpdates += middle;
+        }
+    }
+    return sums;
+}
+
+/**
+ * @brief Checks the updates split into contiguous shards on several threads.
+ *
+ * Every thread sums its own shard; the shard sums are added up in shard order after joining,
+ * so the result does not depend on the number of threads or their timing.
+ *
+ * @param numberOfThreads How many shards to check in parallel, at most one per core; 0 picks
+ *                        one per core, limited so that every shard has at least 10 000 updates.
+ */
+inline UpdateSums check_updates_parallel(const PageRules &rules, const PageRanking &ranking, const Updates &updates,
+                                         const CheckOptions &options, size_t numberOfThreads = 0) {
+    constexpr size_t MIN_SHARD_SIZE = 10000;
+    size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    if (numberOfThreads == 0) {
+        numberOfThreads = std::min(cores, updates.size() / MIN_SHARD_SIZE + 1);
+    }
+    numberOfThreads = std::min(numberOfThreads, cores); // more threads than cores only add switching
+
+    std::vector<UpdateSums> shardSums(numberOfThreads);
+    std::vector<std::thread> workers;
+    size_t shardSize = updates.size() / numberOfThreads + 1;
+    for (size_t t = 0; t < numberOfThreads; ++t) {
+        size_t first = std::min(updates.size(), t * shardSize);
+        size_t last = std::min(updates.size(), first + shardSize);
+        workers.emplace_back([&, t, first, last]() { shardSums[t] = check_updates(rules, ranking, updates, first, last, options); });
+    }
+
+    UpdateSums total;
+    for (size_t t = 0; t < numberOfThreads; ++t) {
+        workers[t].join();
+        total += shardSums[t];
+    }
+    return total;
+}
+
+#endif // AOC_2024_DAY5_UPDATE_CHECKS_HPP
@@ -0,0 +1,276 @@
+#ifndef AOC_2024_DAY6_GUARD_WALK_HPP
+#define AOC_2024_DAY6_GUARD_WALK_HPP
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+#include "../common/grid.hpp"
+#include "../common/log.hpp"
+#include "visited-states.hpp"
+
+/**
+ * @brief Enum to represent the direction the guard is facing.
+ */
+enum Direction
+{
+    UP,
+    RIGHT,
+    DOWN,
+    LEFT
+};
+
+/**
+ * @brief Value of the grid border; stepping onto it means the guard has left the mapped area.
+ */
+constexpr char OUTSIDE = '\0';
+
+/**
+ * @brief Size of the puzzle input, which gets a fixed-size grid.
+ */
+using InputShape = GridShape<130, 130>;
+
+/**
+ * @brief Turns the guard 90 degrees to the right.
+ *
+ * @param dir The current direction of the guard.
+ */
+inline void turnRight(Direction &dir)
+{
+    dir = static_cast<Direction>((dir + 1) % 4);
+}
+
+/**
+ * @brief Checks if the given cell is an obstacle.
+ *
+ * @param grid The grid representing the map.
+ * @param cell The flat index of the cell.
+ * @return true if the cell is an obstacle, false otherwise.
+ */
+template <typename GridT>
+bool isObstacle(const GridT &grid, size_t cell)
+{
+    return grid[cell] == '#';
+}
+
+/**
+ * @brief Checks if the guard is stuck in a loop.
+ *
+ * The function tracks the guard's position and direction and checks if this combination
+ * has already occurred. If the same (position, direction) pair is encountered again,
+ * the guard is stuck in a loop.
+ *
+ * @param visitedStates The previously seen (position, direction) pairs of the current walk.
+ * @param pos The flat index of the guard's current cell.
+ * @param dir The current direction of the guard.
+ * @return true if the current (position, direction) pair has been seen before, false otherwise.
+ */
+inline bool isStuckInLoop(VisitedStates &visitedStates, size_t pos, const Direction &dir)
+{
+    return !visitedStates.insert(pos, dir); // already there: loop detected
+}
+
+/**
+ * @brief Returns the flat index of the guard's starting cell.
+ */
+template <typename GridT>
+size_t findStartPosition(const GridT &grid)
+{
+    size_t pos = 0;
+    // Find the initial position of the guard
+    for (int i = 0; i < grid.rows(); ++i)
+    {
+        for (int j = 0; j < grid.cols(); ++j)
+        {
+            if (grid(i, j) == '^')
+            {
+                pos = grid.index(i, j);
+                break;
+            }
+        }
+    }
+    return pos;
+}
+
+/**
+ * @brief Navigates the grid according to the given protocol and returns the number of distinct positions visited.
+ *
+ * @param grid The grid representing the map, with a border of at least one cell.
+ * @return The number of distinct positions visited by the guard.
+ */
+template <typename GridT>
+int navigateGrid(GridT &grid)
+{
+    size_t pos = 0;
+    Direction dir = UP;
+    // flat index offsets in the order of the Direction enum
+    const std::array<std::ptrdiff_t, 4> steps = grid.orthogonalOffsets();
+
+    // Find the initial position of the guard
+    for (int i = 0; i < grid.rows(); ++i)
+    {
+        for (int j = 0; j < grid.cols(); ++j)
+        {
+            if (grid(i, j) == '^')
+            {
+                pos = grid.index(i, j);
+                grid[pos] = '.'; // Clear the initial position
+                break;
+            }
+        }
+    }
+
+    VisitedStates visited(grid.cellCount(), 1); // cells only, the direction does not matter here
+    visited.startWalk();
+    visited.insert(pos);
+    int distinctPositions = 1;
+
+    while (true)
+    {
+        size_t nextPos = pos + steps[dir];
+
+        if (grid[nextPos] == OUTSIDE)
+        {
+            break; // Guard has left the mapped area
+        }
+
+        if (isObstacle(grid, nextPos))
+        {
+            turnRight(dir);
+        }
+        else
+        {
+            pos = nextPos;
+            distinctPositions += visited.insert(pos);
+        }
+    }
+
+    return distinctPositions;
+}
+
+/**
+ * @brief Navigates the grid according to the given protocol and returns the number of distinct positions visited.
+ *
+ * The function tracks the guard's position and direction and moves it according to the rules of movement
+ * on the grid. It also checks if the guard is stuck in a loop.
+ *
+ * @param grid The grid representing the map, with a border of at least one cell.
+ * @param startPosition The flat index of the guard's starting cell.
+ * @param visitedPositions Scratch set of cells, sized for the grid; reused across calls.
+ * @param visitedStates Scratch set of (cell, direction) pairs, sized for the grid; reused across calls.
+ * @return The number of distinct positions visited by the guard and whether the guard got stuck in a loop.
+ */
+template <typename GridT>
+std::pair<int, bool> navigateGrid(const GridT &grid, size_t startPosition,
+                                  VisitedStates &visitedPositions, VisitedStates &visitedStates)
+{
+    size_t pos = startPosition;
+    Direction dir = UP;
+    // flat index offsets in the order of the Direction enum
+    const std::array<std::ptrdiff_t, 4> steps = grid.orthogonalOffsets();
+
+    visitedPositions.startWalk();
+    visitedStates.startWalk();
+    visitedPositions.insert(pos);
+    visitedStates.insert(pos, dir);
+    int distinctPositions = 1;
+
+    while (true)
+    {
+        size_t nextPos = pos + steps[dir];
+
+        // Check if the guard is out of bounds
+        if (grid[nextPos] == OUTSIDE)
+        {
+            break; // Guard has left the mapped area
+        }
+
+        // Check if the position is an obstacle
+        if (isObstacle(grid, nextPos))
+        {
+            turnRight(dir);
+        }
+        else
+        {
+            pos = nextPos;
+            distinctPositions += visitedPositions.insert(pos);
+        }
+
+        // Check if the guard is stuck in a loop
+        if (isStuckInLoop(visitedStates, pos, dir))
+        {
+            // std::cout << "Guard is stuck in a loop." << std::endl;
+            return {distinctPositions, true};
+        }
+    }
+
+    return {distinctPositions, false};
+}
+
+/**
+ * @brief Prints the 2D grid to the console.
+ *
+ * This function prints each row of the grid on a new line, providing a visual
+ * representation of the current state of the grid.
+ *
+ * @param grid The grid to print.
+ */
+template <typename GridT>
+void printGrid(const GridT &grid)
+{
+    for (int i = 0; i < grid.rows(); ++i)
+    {
+        LOG_DEBUG(std::string_view(&grid(i, 0), grid.cols()));
+    }
+}
+
+/**
+ * @brief Counts the cells where a new obstruction would trap the guard in a loop.
+ *
+ * Every free cell except the starting one gets an obstruction in turn and the guard's walk is replayed.
+ * All walks share the same visited sets, which start each walk empty without being cleared.
+ *
+ * @param grid The grid representing the map, with a border of at least one cell; it is restored before returning.
+ * @return The number of cells where an obstruction makes the guard loop.
+ */
+template <typename GridT>
+int countObstructionLocations(GridT &grid)
+{
+    std::pair<int, bool> distPositionsAndIsItLoop;
+    size_t startPosition = findStartPosition(grid);
+    LOG_INFO("Start position (", grid.row(startPosition), ",", grid.col(startPosition), ")");
+    char gridCurrentItem;
+    int numberOfValidObstructionLocations = 0;
+    VisitedStates visitedPositions(grid.cellCount(), 1);
+    VisitedStates visitedStates(grid.cellCount(), 4);
+    for (int i = 0; i < grid.rows(); ++i)
+    {
+        for (int j = 0; j < grid.cols(); ++j)
+        {
+            size_t cell = grid.index(i, j);
+            if (cell == startPosition || grid[cell] == '#')
+            {
+                continue;
+            }
+            else
+            {
+                LOG_DEBUG("Current position (", i, ",", j, ")");
+                gridCurrentItem = grid[cell];
+                grid[cell] = '#';
+                // printGrid(grid);
+                distPositionsAndIsItLoop = navigateGrid(grid, startPosition, visitedPositions, visitedStates);
+                grid[cell] = gridCurrentItem; // Revert grid as it was
+                if (distPositionsAndIsItLoop.second)
+                {
+                    LOG_DEBUG("Guard is stuck in a loop.");
+                    // std::cout << "Loop created by adding obstriction at (" << i << "," << j << ")" << std::endl;
+                    numberOfValidObstructionLocations++;
+                }
+            }
+        }
+    }
+    return numberOfValidObstructionLocations;
+}
+
+#endif // AOC_2024_DAY6_GUARD_WALK_HPP
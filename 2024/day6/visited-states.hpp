@@ -0,0 +1,66 @@
+#ifndef AOC_2024_DAY6_VISITED_STATES_HPP
+#define AOC_2024_DAY6_VISITED_STATES_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Set of (cell, direction) states of a walk, reusable across many walks.
+ *
+ * Every state has a slot in a dense array indexed by flat cell index and direction, holding the
+ * number of the walk (the epoch) that last visited it. A state belongs to the current walk if its
+ * stamp equals the current epoch, so starting a new walk is just incrementing the epoch instead
+ * of clearing the array. Only when the 16-bit epoch wraps around is the array cleared once.
+ *
+ * @code
+ * VisitedStates visited(grid.cellCount(), 4);
+ * visited.startWalk();
+ * bool isNew = visited.insert(cell, direction);
+ * @endcode
+ */
+class VisitedStates
+{
+public:
+    /**
+     * @param cellCount Number of flat cell indices, border included.
+     * @param directions Number of states per cell; 1 to track cells only.
+     */
+    VisitedStates(size_t cellCount, int directions) : directions_(directions), stamps_(cellCount * directions, 0) {}
+
+    /**
+     * @brief Forgets all states, making the set empty for the next walk.
+     */
+    void startWalk()
+    {
+        if (++epoch_ == 0)
+        {
+            std::fill(stamps_.begin(), stamps_.end(), 0);
+            epoch_ = 1;
+        }
+    }
+
+    /**
+     * @brief Adds a state.
+     *
+     * @return true if the state was not in the set yet.
+     */
+    bool insert(size_t cell, int direction = 0)
+    {
+        uint16_t &stamp = stamps_[cell * directions_ + direction];
+        if (stamp == epoch_)
+        {
+            return false;
+        }
+        stamp = epoch_;
+        return true;
+    }
+
+private:
+    size_t directions_;
+    uint16_t epoch_ = 1; // 0 marks slots no walk has visited
+    std::vector<uint16_t> stamps_;
+};
+
+#endif // AOC_2024_DAY6_VISITED_STATES_HPP
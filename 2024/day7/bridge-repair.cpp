@@ -1,9 +1,14 @@
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <string>
 #include <vector>
 #include <map>
+#include <algorithm>
+#include <string_view>
+#include <cstdint>
+
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+#include "../common/number-parser.hpp"
 
 /**
  * @brief Removes the last element from the vector and returns the modified vector.
@@ -80,66 +85,56 @@ int main(int argc, char *argv[])
     }
 
     std::string filename = argv[1];
-    std::ifstream file(filename);
+    InputView input(filename);
     std::map<long long, std::vector<int>> data;
-    std::string line;
+    std::vector<int64_t> numbers;
+    std::vector<size_t> lineOffsets;
     long long sumOfTrueEquations = 0;
 
-    if (!file.is_open())
+    if (!input.isOpen())
     {
         std::cerr << "Unable to open file" << std::endl;
         return 1;
     }
 
-    while (std::getline(file, line))
+    // every line is "<test value>: <numbers...>"
+    parseIntegers(input.data(), numbers, &lineOffsets);
+
+    // the numbers of row l come from line l, so the lines are walked alongside to check the ':'
+    std::string_view text = input.data();
+    size_t lineStart = 0;
+    for (size_t l = 0; l + 1 < lineOffsets.size(); ++l)
     {
-        if (line.empty())
+        size_t lineEnd = std::min(text.find('\n', lineStart), text.size());
+        std::string_view line = text.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+        if (line.empty() || line == "\r")
             continue;
 
-        std::size_t colonPos = line.find(':');
-        if (colonPos == std::string::npos)
+        size_t first = lineOffsets[l];
+        size_t last = lineOffsets[l + 1];
+        if (line.find(':') == std::string_view::npos || last - first < 2)
         {
             std::cerr << "Invalid line format: " << line << std::endl;
             continue;
         }
 
-        std::string keyPart = line.substr(0, colonPos);
-        long long key = std::stoll(keyPart);
-
-        std::string valuesPart = line.substr(colonPos + 1);
-        valuesPart.erase(0, valuesPart.find_first_not_of(" "));
-
-        std::stringstream ss(valuesPart);
-        std::vector<int> values;
-        int value;
-        while (ss >> value)
-        {
-            values.push_back(value);
-        }
-
-        data[key] = values;
+        data[numbers[first]] = std::vector<int>(numbers.begin() + first + 1, numbers.begin() + last);
     }
 
-    file.close();
-
-    std::cout << "Parsed data:" << std::endl;
+    LOG_DEBUG("Parsed data:");
     for (const auto &pair : data)
     {
-        std::cout << pair.first << ": ";
-        for (int value : pair.second)
-        {
-            std::cout << value << " ";
-        }
-        std::cout << std::endl;
+        LOG_DEBUG(pair.first, ": ", logging::joined(pair.second));
 
         if (checkIfEquationCanBeTrue(pair.first, pair.second))
         {
-            std::cout << "OK" << std::endl;
+            LOG_DEBUG("OK");
             sumOfTrueEquations += pair.first;
         }
     }
 
-    std::cout << "Total calibration result: " << sumOfTrueEquations << std::endl;
+    results() << "Total calibration result: " << sumOfTrueEquations << '\n';
 
     return 0;
 }
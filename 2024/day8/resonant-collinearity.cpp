@@ -1,9 +1,12 @@
 #include <iostream>
-#include <fstream>
 #include <vector>
 #include <map>
 #include <set>
 
+#include "../common/grid.hpp"
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+
 /**
  * @brief Represents a position on a 2D grid with (x, y) coordinates.
  *
@@ -31,6 +34,14 @@ struct Position
     }
 };
 
+/**
+ * @brief Writes a position as "(x,y)", for the debug output.
+ */
+std::ostream &operator<<(std::ostream &os, const Position &position)
+{
+    return os << "(" << position.x << "," << position.y << ")";
+}
+
 /**
  * @brief Main function that reads a grid from a file and processes antenna locations.
  *
@@ -50,20 +61,16 @@ int main(int argc, char *argv[])
     }
 
     std::string filename = argv[1];
-    std::ifstream file(filename);
-    std::vector<std::string> grid;
+    InputView input(filename);
+    Grid<char> grid;
     std::map<char, std::set<Position>> antennaLocations;
-    std::set<Position> antinodes;
+    Grid<char> antinodes; // 1 for cells holding an antinode
     int numberOfAntinodesInsideGrid = 0;
 
-    if (file.is_open())
+    if (input.isOpen())
     {
-        std::string line;
-        while (std::getline(file, line))
-        {
-            grid.push_back(line);
-        }
-        file.close();
+        grid = loadGrid(input, 0, '.');
+        antinodes = Grid<char>(grid.rows(), grid.cols(), 0, 0);
     }
     else
     {
@@ -72,30 +79,24 @@ int main(int argc, char *argv[])
     }
 
     Position antPos;
-    for (int i = 0; i < grid.size(); ++i)
+    for (int i = 0; i < grid.rows(); ++i)
     {
-        for (int j = 0; j < grid[i].size(); ++j)
+        for (int j = 0; j < grid.cols(); ++j)
         {
-            std::cout << grid[i][j] << " ";
-            if (grid[i][j] != '.')
+            if (grid(i, j) != '.')
             {
                 antPos.x = i;
                 antPos.y = j;
-                antennaLocations[grid[i][j]].insert(antPos);
+                antennaLocations[grid(i, j)].insert(antPos);
             }
         }
-        std::cout << std::endl;
+        LOG_DEBUG(logging::joined(std::string_view(&grid(i, 0), grid.cols())));
     }
 
     for (const auto &antenna : antennaLocations)
     {
-        std::cout << "Antenna: " << antenna.first << std::endl;
-        std::cout << "Locations: ";
-        for (const auto &loc : antenna.second)
-        {
-            std::cout << "(" << loc.x << "," << loc.y << ") ";
-        }
-        std::cout << std::endl;
+        LOG_DEBUG("Antenna: ", antenna.first);
+        LOG_DEBUG("Locations: ", logging::joined(antenna.second));
         for (size_t i = 0; i < antenna.second.size(); ++i)
         {
             for (size_t j = i + 1; j < antenna.second.size(); ++j)
@@ -109,24 +110,33 @@ int main(int argc, char *argv[])
                 pos2 = *itSecond;
                 antinode.x = (2 * pos1.x - pos2.x);
                 antinode.y = (2 * pos1.y - pos2.y);
-                antinodes.insert(antinode);
+                if (grid.contains(antinode.x, antinode.y))
+                {
+                    antinodes(antinode.x, antinode.y) = 1;
+                }
                 antinode.x = (2 * pos2.x - pos1.x);
                 antinode.y = (2 * pos2.y - pos1.y);
-                antinodes.insert(antinode);
+                if (grid.contains(antinode.x, antinode.y))
+                {
+                    antinodes(antinode.x, antinode.y) = 1;
+                }
             }
         }
     }
 
-    for (const auto &antinode : antinodes)
+    for (int i = 0; i < antinodes.rows(); ++i)
     {
-        if (antinode.x >= 0 && antinode.x < grid.size() && antinode.y >= 0 && antinode.y < grid[0].size())
+        for (int j = 0; j < antinodes.cols(); ++j)
         {
-            std::cout << "Antinode: (" << antinode.x << "," << antinode.y << ") " << std::endl;
-            numberOfAntinodesInsideGrid++;
+            if (antinodes(i, j))
+            {
+                LOG_DEBUG("Antinode: (", i, ",", j, ") ");
+                numberOfAntinodesInsideGrid++;
+            }
         }
     }
 
-    std::cout << "Number of unique antinode locations within the bounds of the map: " << numberOfAntinodesInsideGrid << std::endl;
+    results() << "Number of unique antinode locations within the bounds of the map: " << numberOfAntinodesInsideGrid << '\n';
 
     return 0;
 }
\ No newline at end of file
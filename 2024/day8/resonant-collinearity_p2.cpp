@@ -1,9 +1,12 @@
 #include <iostream>
-#include <fstream>
 #include <vector>
 #include <map>
 #include <set>
 
+#include "../common/grid.hpp"
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+
 /**
  * @brief Represents a position on a 2D grid with (x, y) coordinates.
  *
@@ -31,6 +34,14 @@ struct Position
     }
 };
 
+/**
+ * @brief Writes a position as "(x,y)", for the debug output.
+ */
+std::ostream &operator<<(std::ostream &os, const Position &position)
+{
+    return os << "(" << position.x << "," << position.y << ")";
+}
+
 /**
  * @brief Main function that reads a grid from a file and processes antenna locations.
  *
@@ -50,20 +61,16 @@ int main(int argc, char *argv[])
     }
 
     std::string filename = argv[1];
-    std::ifstream file(filename);
-    std::vector<std::string> grid;
+    InputView input(filename);
+    Grid<char> grid;
     std::map<char, std::set<Position>> antennaLocations;
-    std::set<Position> antinodes;
+    Grid<char> antinodes; // 1 for cells holding an antinode
     int numberOfAntinodesInsideGrid = 0;
 
-    if (file.is_open())
+    if (input.isOpen())
     {
-        std::string line;
-        while (std::getline(file, line))
-        {
-            grid.push_back(line);
-        }
-        file.close();
+        grid = loadGrid(input, 0, '.');
+        antinodes = Grid<char>(grid.rows(), grid.cols(), 0, 0);
     }
     else
     {
@@ -71,28 +78,22 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    for (int i = 0; i < grid.size(); ++i)
+    for (int i = 0; i < grid.rows(); ++i)
     {
-        for (int j = 0; j < grid[i].size(); ++j)
+        for (int j = 0; j < grid.cols(); ++j)
         {
-            std::cout << grid[i][j] << " ";
-            if (grid[i][j] != '.')
+            if (grid(i, j) != '.')
             {
-                antennaLocations[grid[i][j]].insert({i, j});
+                antennaLocations[grid(i, j)].insert({i, j});
             }
         }
-        std::cout << std::endl;
+        LOG_DEBUG(logging::joined(std::string_view(&grid(i, 0), grid.cols())));
     }
 
     for (const auto &antenna : antennaLocations)
     {
-        std::cout << "Antenna: " << antenna.first << std::endl;
-        std::cout << "Locations: ";
-        for (const auto &loc : antenna.second)
-        {
-            std::cout << "(" << loc.x << "," << loc.y << ") ";
-        }
-        std::cout << std::endl;
+        LOG_DEBUG("Antenna: ", antenna.first);
+        LOG_DEBUG("Locations: ", logging::joined(antenna.second));
         for (size_t i = 0; i < antenna.second.size(); ++i)
         {
             for (size_t j = 0; j < antenna.second.size(); ++j)
@@ -112,9 +113,9 @@ int main(int argc, char *argv[])
                 antinode.x = pos1.x;
                 antinode.y = pos1.y;
 
-                while (antinode.x >= 0 && antinode.x < grid.size() && antinode.y >= 0 && antinode.y < grid[0].size())
+                while (grid.contains(antinode.x, antinode.y))
                 {
-                    antinodes.insert(antinode); //since antennas also count as antinodes
+                    antinodes(antinode.x, antinode.y) = 1; //since antennas also count as antinodes
                     antinode.x += directionX;
                     antinode.y += directionY;
                 }
@@ -122,13 +123,19 @@ int main(int argc, char *argv[])
         }
     }
 
-    for (const auto &antinode : antinodes)
+    for (int i = 0; i < antinodes.rows(); ++i)
     {
-        std::cout << "Antinode: (" << antinode.x << "," << antinode.y << ") " << std::endl;
-        numberOfAntinodesInsideGrid++;
+        for (int j = 0; j < antinodes.cols(); ++j)
+        {
+            if (antinodes(i, j))
+            {
+                LOG_DEBUG("Antinode: (", i, ",", j, ") ");
+                numberOfAntinodesInsideGrid++;
+            }
+        }
     }
 
-    std::cout << "Number of unique antinode locations within the bounds of the map: " << numberOfAntinodesInsideGrid << std::endl;
+    results() << "Number of unique antinode locations within the bounds of the map: " << numberOfAntinodesInsideGrid << '\n';
 
     return 0;
 }
\ No newline at end of file
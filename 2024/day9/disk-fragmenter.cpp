@@ -1,9 +1,10 @@
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <vector>
 #include <cctype> //isdigit
 
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+
 /**
  * @brief Converts a character to an integer.
  *
@@ -88,12 +89,11 @@ long long fragmentMemory(std::vector<long long> &expandedMapView)
         }
     }
 
+    LOG_DEBUG(logging::joined(expandedMapView));
     for (size_t i = 0; i < expandedMapView.size(); ++i)
     {
-        std::cout << expandedMapView[i] << " ";
         checksum += i * expandedMapView[i];
     }
-    std::cout << std::endl;
     return checksum;
 }
 
@@ -117,46 +117,34 @@ int main(int argc, char *argv[])
 
     std::string filename = argv[1];
 
-    std::ifstream file(filename);
+    InputView input(filename);
     std::vector<long long> data;
-    char numberChar;
     long long number;
     long long checksum;
     std::vector<long long> expandedDiskMap;
 
-    if (!file.is_open())
+    if (!input.isOpen())
     {
         std::cerr << "ERROR: Could not open the file";
         return 1;
     }
 
-    while (file.get(numberChar))
+    data.reserve(input.size());
+    for (char numberChar : input.data())
     {
         number = charToInt(numberChar);
         data.push_back(number);
     }
 
-    file.close();
-
     expandedDiskMap = expandMapView(data);
 
-    for (const auto &num : expandedDiskMap)
-    {
-        std::cout << num << " ";
-    }
-
-    std::cout << std::endl;
+    LOG_DEBUG(logging::joined(expandedDiskMap));
 
     checksum = fragmentMemory(expandedDiskMap);
 
-    for (const auto &num : expandedDiskMap)
-    {
-        std::cout << num << " ";
-    }
-
-    std::cout << std::endl;
+    LOG_DEBUG(logging::joined(expandedDiskMap));
 
-    std::cout << "Filesystem checksum: " << checksum << std::endl;
+    results() << "Filesystem checksum: " << checksum << '\n';
 
     return 0;
 }
\ No newline at end of file
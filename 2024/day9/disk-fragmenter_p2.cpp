@@ -1,10 +1,11 @@
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <vector>
 #include <cctype> //isdigit
 #include <map>
 
+#include "../common/input-view.hpp"
+#include "../common/log.hpp"
+
 /**
  * @brief Converts a character to its corresponding integer value.
  * 
@@ -135,7 +136,6 @@ long long fragmentMemory(std::pair<std::map<int, std::pair<int, int>>, std::vect
             checksum += fileIndex * i;
         }
     }
-    std::cout << std::endl;
     return checksum;
 }
 
@@ -159,27 +159,25 @@ int main(int argc, char *argv[])
 
     std::string filename = argv[1];
 
-    std::ifstream file(filename);
+    InputView input(filename);
     std::vector<long long> data;
-    char numberChar;
     long long number;
     long long checksum;
     std::pair<std::map<int, std::pair<int, int>>, std::vector<std::pair<int, int>>> expandedDiskMap;
 
-    if (!file.is_open())
+    if (!input.isOpen())
     {
         std::cerr << "ERROR: Could not open the file";
         return 1;
     }
 
-    while (file.get(numberChar))
+    data.reserve(input.size());
+    for (char numberChar : input.data())
     {
         number = charToInt(numberChar);
         data.push_back(number);
     }
 
-    file.close();
-
     expandedDiskMap = expandMapView(data);
 
     // for (const auto &[fileIndex, posAndLenght] : expandedDiskMap.first)
@@ -204,7 +202,7 @@ int main(int argc, char *argv[])
 
     // std::cout << std::endl;
 
-    std::cout << "Filesystem checksum: " << checksum << std::endl;
+    results() << "Filesystem checksum: " << checksum << '\n';
 
     return 0;
 }
\ No newline at end of file